@@ -18,6 +18,7 @@
 #include "App.h"
 #include "AppVersion.h"
 #include "utils/PlatformUtils.h"
+#include "graphics/GraphicOverlay.h"
 #include <QtPlugin>
 #include <QStyleFactory>
 #include <QPixmap>
@@ -49,9 +50,17 @@ App::App(int &argc, char **argv): QApplication(argc, argv) {     // NOLINT(cppco
     // Determine if running in development mode.
     const bool devMode = findDevMode(parser);
 
+    // Draw the tool graphics into an overlay window per screen, if requested. This must be decided before any
+    // graphic is created.
+    GraphicOverlay::setEnabled(parser.isSet(k_overlayOpt) && PlatformUtils::isX11());
+
     // Create the singleton objects.
     m_screenInfo = new ScreenInfo(screens());                                                     // NOLINT(cppcoreguidelines-prefer-member-initializer)
     m_unitsMgr = new UnitsMgr(m_screenInfo);                                                      // NOLINT(cppcoreguidelines-prefer-member-initializer)
+
+    // The units must recompute their conversion factors before any other object responds to a resolution change.
+    connect(m_screenInfo, &ScreenInfo::resolutionChanged, m_unitsMgr, &UnitsMgr::resolutionChanged);
+
     m_toolMgr = new ToolMgr(m_screenInfo, m_unitsMgr);                                            // NOLINT(cppcoreguidelines-prefer-member-initializer)
     m_posLogMgr = new PosLogMgr(m_screenInfo, m_unitsMgr, m_toolMgr);                             // NOLINT(cppcoreguidelines-prefer-member-initializer)
     m_configMgr = new ConfigMgr(devMode);                                                         // NOLINT(cppcoreguidelines-prefer-member-initializer)
@@ -110,11 +119,14 @@ void App::parseCommandLine(QCommandLineParser& parser) {
 
     const QCommandLineOption resetOption(k_resetOpt, tr("Performs a hard reset."));
 
+    const QCommandLineOption overlayOption(k_overlayOpt, tr("Draws the tool graphics in a single overlay per screen."));
+
     parser.setApplicationDescription("A tool for easily measuring and capturing portions of the screen.");
     parser.addHelpOption();
     parser.addVersionOption();
     parser.addOption(devModeOption);
     parser.addOption(resetOption);
+    parser.addOption(overlayOption);
     parser.addPositionalArgument("*.mea", tr("Configuration file"), "[*.mea]");
     parser.addPositionalArgument("*.mpl", tr("Position log file"), "[*.mpl]");
     parser.process(*this);
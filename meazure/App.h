@@ -51,6 +51,7 @@ private:
     // Command-line options
     static constexpr const char* k_devmodeOpt { "devmode" };
     static constexpr const char* k_resetOpt { "reset" };
+    static constexpr const char* k_overlayOpt { "overlay" };
 
     static constexpr const char* k_devmodeMarkerFilename { "meadevmode" };
     static constexpr const char* k_icuDir { "icu" };
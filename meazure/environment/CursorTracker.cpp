@@ -16,15 +16,39 @@
  */
 
 #include "CursorTracker.h"
+#include "x11/X11PointerMotionTracker.h"
+#include "noop/NoopPointerMotionTracker.h"
+#include <meazure/utils/PlatformUtils.h>
 #include <QCursor>
 
 
 CursorTracker::CursorTracker(QObject *parent) : QObject(parent) {
+    if (PlatformUtils::isX11()) {
+        m_motionTracker = new X11PointerMotionTracker(this);
+    } else {
+        m_motionTracker = new NoopPointerMotionTracker(this);
+    }
+
+    connect(&m_reportPacer, &RefreshPacer::triggered, this, &CursorTracker::reportPosition);
+
+    connect(dynamic_cast<const QObject*>(m_motionTracker), SIGNAL(pointerMoved()), this, SLOT(pointerMoved()));
 }
 
 void CursorTracker::start() {
     stop();
-    m_timerId = startTimer(k_updateRate);
+
+    if (m_motionTracker->isSupported()) {
+        // Reading the cursor location requires a round trip to the display server, so it is read at most once
+        // per display refresh regardless of how many motion events are received.
+        m_reportPacer.updateInterval();
+
+        m_motionTracker->start();
+
+        // Report the initial position.
+        pointerMoved();
+    } else {
+        m_timerId = startTimer(k_updateRate);
+    }
 }
 
 void CursorTracker::stop() {
@@ -32,8 +56,20 @@ void CursorTracker::stop() {
         killTimer(m_timerId);
         m_timerId = 0;
     }
+
+    m_motionTracker->stop();
+    m_reportPacer.stop();
 }
 
 void CursorTracker::timerEvent(QTimerEvent*) {
     emit motion(QCursor::pos());
 }
+
+void CursorTracker::pointerMoved() {
+    // Motion following a pause is reported immediately. Continuous motion is reported once per refresh interval.
+    m_reportPacer.schedule();
+}
+
+void CursorTracker::reportPosition() {
+    emit motion(QCursor::pos());
+}
@@ -17,11 +17,15 @@
 
 #pragma once
 
+#include "PointerMotionTracker.h"
+#include <meazure/utils/RefreshPacer.h>
 #include <QObject>
+#include <QPoint>
 
 
-/// Tracks the position of the cursor regardless of whether the application has focus. This is accomplished by
-/// using a timer to periodically read the cursor location.
+/// Tracks the position of the cursor regardless of whether the application has focus. When the platform can report
+/// pointer motion (e.g. XInput2 on X11), the cursor location is only read after the pointer has moved, and no more
+/// often than the display refresh rate. Otherwise, a timer is used to periodically read the cursor location.
 ///
 class CursorTracker : public QObject {
 
@@ -48,8 +52,14 @@ signals:
 protected:
     void timerEvent(QTimerEvent *event) override;
 
+private slots:
+    void pointerMoved();
+    void reportPosition();
+
 private:
-    static constexpr int k_updateRate { 30 };       // Milliseconds
+    static constexpr int k_updateRate { 30 };           // Polling rate if motion cannot be tracked, milliseconds
 
+    PointerMotionTracker* m_motionTracker;
+    RefreshPacer m_reportPacer;         ///< Paces reading the cursor location to the display refresh
     int m_timerId { 0 };
 };
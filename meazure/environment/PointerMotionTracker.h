@@ -0,0 +1,55 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+
+
+/// Reports that the pointer has moved, without polling.
+///
+struct PointerMotionTracker {
+
+    PointerMotionTracker() = default;
+    virtual ~PointerMotionTracker() = default;
+
+    PointerMotionTracker(const PointerMotionTracker&) = delete;
+    PointerMotionTracker(PointerMotionTracker&&) = delete;
+    PointerMotionTracker& operator=(const PointerMotionTracker&) = delete;
+
+    /// Indicates whether pointer motion tracking is supported on the implementing platform.
+    ///
+    /// @return true if pointer motion tracking is supported.
+    ///
+    [[nodiscard]] virtual bool isSupported() const = 0;
+
+    /// Starts tracking pointer motion and emitting pointerMoved signals.
+    ///
+    virtual void start() = 0;
+
+    /// Stops tracking pointer motion.
+    ///
+    virtual void stop() = 0;
+
+signals:
+    /// Emitted when the pointer has moved. Several movements may be reported by a single signal. The signal does
+    /// not provide the pointer position.
+    ///
+    virtual void pointerMoved() = 0;
+};
+
+Q_DECLARE_INTERFACE(PointerMotionTracker, "PointerMotionTracker")
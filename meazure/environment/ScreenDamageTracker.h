@@ -0,0 +1,61 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QRect>
+
+
+/// Tracks changes to the contents of an area of the screen.
+///
+struct ScreenDamageTracker {
+
+    ScreenDamageTracker() = default;
+    virtual ~ScreenDamageTracker() = default;
+
+    ScreenDamageTracker(const ScreenDamageTracker&) = delete;
+    ScreenDamageTracker(ScreenDamageTracker&&) = delete;
+    ScreenDamageTracker& operator=(const ScreenDamageTracker&) = delete;
+
+    /// Indicates whether screen damage tracking is supported on the implementing platform.
+    ///
+    /// @return true if screen damage tracking is supported.
+    ///
+    [[nodiscard]] virtual bool isSupported() const = 0;
+
+    /// Starts tracking changes to the screen contents and emitting damaged signals.
+    ///
+    virtual void start() = 0;
+
+    /// Stops tracking changes to the screen contents.
+    ///
+    virtual void stop() = 0;
+
+    /// Sets the area of the screen to watch. Changes to the screen contents outside of this area are ignored.
+    ///
+    /// @param[in] rect Area of the screen to watch, in pixels
+    ///
+    virtual void setWatchRect(const QRect& rect) = 0;
+
+signals:
+    /// Emitted when the contents of the watched area of the screen have changed.
+    ///
+    virtual void damaged() = 0;
+};
+
+Q_DECLARE_INTERFACE(ScreenDamageTracker, "ScreenDamageTracker")
@@ -16,14 +16,17 @@
  */
 
 #include "ScreenInfo.h"
+#include "x11/X11ScreenGrabber.h"
 #include <meazure/utils/Geometry.h>
 #include <meazure/utils/StringUtils.h>
+#include <meazure/utils/PlatformUtils.h>
 #include <QScreen>
 #include <QRect>
 #include <QSizeF>
 #include <QApplication>
 #include <QMainWindow>
 #include <QPixmap>
+#include <QThread>
 #include <qpa/qplatformcursor.h>
 #include <limits>
 #include <algorithm>
@@ -155,14 +158,26 @@ ScreenInfo::ScreenInfo(const QList<QScreen*>& screens) : m_numScreens(static_cas
         m_screens.push_back(screen);
     }
 
+    m_screenIndex = Geometry::RectIndex(m_screens);
+
     m_virtualGeometry = screens[0]->virtualGeometry();
     m_availableVirtualGeometry = screens[0]->availableVirtualGeometry();
+
+    if (PlatformUtils::isX11()) {
+        m_screenGrabber = new X11ScreenGrabber();
+        if (!m_screenGrabber->isSupported()) {
+            delete m_screenGrabber;
+            m_screenGrabber = nullptr;
+        }
+    }
 }
 
 ScreenInfo::~ScreenInfo() {
     for (int i = 0; i < m_numScreens; i++) {
         delete m_screens[i];
     }
+
+    delete m_screenGrabber;
 }
 
 void ScreenInfo::writeConfig(Config& config) const {
@@ -236,11 +251,11 @@ int ScreenInfo::getNumScreens() const {
 }
 
 int ScreenInfo::screenForPoint(const QPoint& point) const {
-    return Geometry::contains(m_screens, point);
+    return m_screenIndex.find(point);
 }
 
 int ScreenInfo::screenForRect(const QRect& rect) const {
-    return Geometry::contains(m_screens, rect);
+    return m_screenIndex.findBestOverlap(rect);
 }
 
 int ScreenInfo::screenForWindow(const QWidget* wnd) const {
@@ -337,5 +352,22 @@ QPoint ScreenInfo::constrainPosition(const QPoint& point) const {
 }
 
 QImage ScreenInfo::grabScreen(int x, int y, int width, int height) const {
+    // Use shared memory when possible to avoid transferring the image over the X connection and converting it.
+    if (m_screenGrabber != nullptr) {
+        QImage image = m_screenGrabber->grab(QRect(x, y, width, height));
+        if (!image.isNull()) {
+            return image;
+        }
+    }
+
+    // Qt can only grab the screen from the GUI thread.
+    if (QThread::currentThread() != thread()) {
+        return {};
+    }
+
     return QGuiApplication::primaryScreen()->grabWindow(0, x, y, width, height).toImage();
 }
+
+bool ScreenInfo::isGrabThreadSafe() const {
+    return m_screenGrabber != nullptr;
+}
@@ -19,6 +19,7 @@
 
 #include "ScreenInfoProvider.h"
 #include <meazure/config/Config.h>
+#include <meazure/utils/Geometry.h>
 #include <QObject>
 #include <QList>
 #include <QScreen>
@@ -26,6 +27,7 @@
 
 
 class App;
+class X11ScreenGrabber;
 
 
 class ScreenInfo : public QObject, public ScreenInfoProvider {
@@ -119,6 +121,8 @@ public:
 
     [[nodiscard]] QImage grabScreen(int x, int y, int width, int height) const override;
 
+    [[nodiscard]] bool isGrabThreadSafe() const override;
+
 signals:
     void resolutionChanged();
 
@@ -135,9 +139,11 @@ private:
 
     int m_numScreens;
     Screens m_screens;
+    Geometry::RectIndex m_screenIndex;      ///< Used to find the screen containing a point or rectangle
     QRect m_virtualGeometry;
     QRect m_availableVirtualGeometry;
     bool m_sizeChanged { false };   ///< Virtual screen rectangle changed since last run.
+    X11ScreenGrabber* m_screenGrabber { nullptr };  ///< Shared memory screen grabber, if supported.
 
     friend class App;
 };
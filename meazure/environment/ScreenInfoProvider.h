@@ -17,13 +17,15 @@
 
 #pragma once
 
-#include <QWidget>
 #include <QPoint>
 #include <QRect>
 #include <QSizeF>
 #include <QImage>
 
 
+class QWidget;
+
+
 struct ScreenInfoProvider {
 
     ScreenInfoProvider() = default;
@@ -170,4 +172,10 @@ struct ScreenInfoProvider {
     /// @return Image of the screen contents in the specified rectangle
     ///
     [[nodiscard]] virtual QImage grabScreen(int x, int y, int width, int height) const = 0;
+
+    /// Indicates whether grabScreen can be called from a thread other than the GUI thread.
+    ///
+    /// @return true if the screen can be grabbed from any thread.
+    ///
+    [[nodiscard]] virtual bool isGrabThreadSafe() const = 0;
 };
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "WindowTracker.h"
 #include <QPoint>
 #include <QRect>
 
@@ -38,11 +39,18 @@ struct WindowFinder {
     ///
     [[nodiscard]] virtual bool isSupported() const = 0;
 
-    /// Refreshes the internal list of top level windows. Typically, this method should be called whenever there
-    /// is a relevant change to the windows on the screen.
+    /// Refreshes the internal list of top level windows by scanning all windows on the screen. Typically, this
+    /// method should be called when window tracking starts. Once the list has been obtained, it is kept up to date
+    /// by passing window events to the update method.
     ///
     virtual void refresh() = 0;
 
+    /// Updates the internal list of top level windows based on a change to the window hierarchy.
+    ///
+    /// @param[in] event Describes the change to the window hierarchy
+    ///
+    virtual void update(const WindowEvent& event) = 0;
+
     /// Attempts to find geometry of a visible window at the specified position.
     ///
     /// @param[in] position Location at which to find a window
@@ -18,9 +18,37 @@
 #pragma once
 
 #include <QObject>
+#include <QMetaType>
 #include <cstdint>
 
 
+/// A change to the structure of the window hierarchy (e.g. a window has been created, mapped or restacked).
+///
+struct WindowEvent {
+    enum Type {
+        Created,        ///< window has been created as a child of parent
+        Destroyed,      ///< window has been destroyed
+        Mapped,         ///< window has been mapped
+        Unmapped,       ///< window has been unmapped
+        Configured,     ///< window has been moved, resized or restacked directly above the sibling window
+        Reparented,     ///< window has been moved to parent at the x, y location
+        Circulated      ///< window has been raised to the top (onTop is true) or lowered to the bottom of its siblings
+    };
+
+    Type type { Created };
+    unsigned long window { 0 };
+    unsigned long parent { 0 };     ///< New parent window (Created and Reparented)
+    unsigned long sibling { 0 };    ///< Sibling directly below the window, or 0 if at the bottom (Configured)
+    bool onTop { false };           ///< Whether the window was raised or lowered (Circulated)
+    int16_t x { 0 };                ///< Location of the left side of the window relative to its parent, in pixels
+    int16_t y { 0 };                ///< Location of the top of the window relative to its parent, in pixels
+    uint16_t width { 0 };           ///< Width of the window, in pixels
+    uint16_t height { 0 };          ///< Height of the window, in pixels
+};
+
+Q_DECLARE_METATYPE(WindowEvent)
+
+
 /// Tracks changes to the position and size of all windows on the screen.
 ///
 struct WindowTracker {
@@ -56,6 +84,12 @@ signals:
     /// @param height Height of the window, in pixels
     ///
     virtual void windowChanged(unsigned long windowId, int16_t x, int16_t y, uint16_t width, uint16_t height) = 0;
+
+    /// Emitted when the structure of the window hierarchy has changed. Events may be reported more than once.
+    ///
+    /// @param event Describes the change
+    ///
+    virtual void windowEvent(const WindowEvent& event) = 0;
 };
 
 Q_DECLARE_INTERFACE(WindowTracker, "WindowTracker")
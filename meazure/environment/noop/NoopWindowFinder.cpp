@@ -25,6 +25,9 @@ bool NoopWindowFinder::isSupported() const {
 void NoopWindowFinder::refresh() {
 }
 
+void NoopWindowFinder::update(const WindowEvent&) {
+}
+
 QRect NoopWindowFinder::find(const QPoint&) {
     return {};
 }
@@ -38,5 +38,7 @@ public:
 
     void refresh() override;
 
+    void update(const WindowEvent& event) override;
+
     QRect find(const QPoint& position) override;
 };
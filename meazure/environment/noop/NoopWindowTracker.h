@@ -44,4 +44,5 @@ public:
 
 signals:
     void windowChanged(unsigned long windowId, int16_t x, int16_t y, uint16_t width, uint16_t height) override;
+    void windowEvent(const WindowEvent& event) override;
 };
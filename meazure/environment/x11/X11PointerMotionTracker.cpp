@@ -0,0 +1,113 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "X11PointerMotionTracker.h"
+#include <meazure/utils/x11/XlibUtils.h>
+#include <X11/extensions/XInput2.h>
+#include <array>
+
+
+X11PointerMotionTracker::X11PointerMotionTracker(QObject* parent) :
+        QObject(parent),
+        m_display(new Xlib::Display()) {
+    int eventBase = 0;
+    int errorBase = 0;
+    if (XQueryExtension(*m_display, "XInputExtension", &m_opcode, &eventBase, &errorBase) == False) {
+        return;
+    }
+
+    // Raw events are only delivered to clients that are not grabbing the pointer starting with version 2.1.
+    int major = 2;
+    int minor = 1;
+    m_supported = (XIQueryVersion(*m_display, &major, &minor) == Success)
+            && (major > 2 || (major == 2 && minor >= 1));
+}
+
+X11PointerMotionTracker::~X11PointerMotionTracker() {
+    stop();
+    delete m_display;
+}
+
+bool X11PointerMotionTracker::isSupported() const {
+    return m_supported;
+}
+
+void X11PointerMotionTracker::start() {
+    stop();
+
+    if (!m_supported) {
+        return;
+    }
+
+    selectEvents(true);
+
+    m_notifier = new QSocketNotifier(ConnectionNumber(m_display->display()), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &X11PointerMotionTracker::processEvents);
+
+    // Events may have been read into the Xlib queue while selecting the events.
+    processEvents();
+}
+
+void X11PointerMotionTracker::stop() {
+    if (m_notifier == nullptr) {
+        return;
+    }
+
+    delete m_notifier;
+    m_notifier = nullptr;
+
+    selectEvents(false);
+
+    // Discard any events that arrived before the selection was removed.
+    XSync(*m_display, True);
+}
+
+void X11PointerMotionTracker::selectEvents(bool select) {
+    std::array<unsigned char, XIMaskLen(XI_LASTEVENT)> mask {};
+    if (select) {
+        XISetMask(mask.data(), XI_RawMotion);
+    }
+
+    XIEventMask eventMask;
+    eventMask.deviceid = XIAllMasterDevices;
+    eventMask.mask_len = static_cast<int>(mask.size());
+    eventMask.mask = mask.data();
+
+    XISelectEvents(*m_display, DefaultRootWindow(m_display->display()), &eventMask, 1);
+    XFlush(*m_display);
+}
+
+void X11PointerMotionTracker::processEvents() {
+    bool moved = false;
+
+    // All pending events are read before signaling so that a burst of motion results in a single signal.
+    while (XPending(*m_display) > 0) {
+        XEvent event;
+        XNextEvent(*m_display, &event);
+
+        XGenericEventCookie* cookie = &event.xcookie;
+        if (cookie->type == GenericEvent && cookie->extension == m_opcode
+                && XGetEventData(*m_display, cookie) == True) {
+            moved = moved || (cookie->evtype == XI_RawMotion);
+            XFreeEventData(*m_display, cookie);
+        }
+    }
+
+    if (moved) {
+        emit pointerMoved();
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <meazure/environment/PointerMotionTracker.h>
+#include <QObject>
+#include <QSocketNotifier>
+
+
+namespace Xlib {
+    class Display;
+}
+
+
+/// Tracks pointer motion using XInput2 raw motion events. Since version 2.1 of the extension, raw events are
+/// delivered to the root window regardless of which client has grabbed the pointer, so motion is seen anywhere on
+/// the screen. Events are read from a dedicated display connection on the GUI thread using a socket notifier, so no
+/// polling is performed while the pointer is still.
+///
+class X11PointerMotionTracker : public QObject, public PointerMotionTracker {
+
+    Q_OBJECT
+    Q_INTERFACES(PointerMotionTracker)
+
+public:
+    explicit X11PointerMotionTracker(QObject* parent = nullptr);
+    ~X11PointerMotionTracker() override;
+
+    X11PointerMotionTracker(const X11PointerMotionTracker&) = delete;
+    X11PointerMotionTracker(X11PointerMotionTracker&&) = delete;
+    X11PointerMotionTracker& operator=(const X11PointerMotionTracker&) = delete;
+
+    [[nodiscard]] bool isSupported() const override;
+
+    void start() override;
+    void stop() override;
+
+signals:
+    void pointerMoved() override;
+
+private slots:
+    void processEvents();
+
+private:
+    void selectEvents(bool select);
+
+    Xlib::Display* m_display;
+    int m_opcode { 0 };         ///< Major opcode of the XInput extension, identifies its generic events
+    bool m_supported { false };
+    QSocketNotifier* m_notifier { nullptr };
+};
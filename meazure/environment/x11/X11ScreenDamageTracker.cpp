@@ -0,0 +1,112 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "X11ScreenDamageTracker.h"
+#include <meazure/utils/x11/XlibUtils.h>
+#include <X11/extensions/Xdamage.h>
+#include <X11/extensions/Xfixes.h>
+
+
+X11ScreenDamageTracker::X11ScreenDamageTracker(QObject* parent) :
+        QObject(parent),
+        m_display(new Xlib::Display()) {
+    int damageErrorBase = 0;
+    int fixesEventBase = 0;
+    int fixesErrorBase = 0;
+    int major = 0;
+    int minor = 0;
+
+    m_supported = (XDamageQueryExtension(*m_display, &m_damageEventBase, &damageErrorBase) == True)
+            && (XDamageQueryVersion(*m_display, &major, &minor) != 0)
+            && (XFixesQueryExtension(*m_display, &fixesEventBase, &fixesErrorBase) == True);
+}
+
+X11ScreenDamageTracker::~X11ScreenDamageTracker() {
+    stop();
+    delete m_display;
+}
+
+bool X11ScreenDamageTracker::isSupported() const {
+    return m_supported;
+}
+
+void X11ScreenDamageTracker::start() {
+    stop();
+
+    if (!m_supported) {
+        return;
+    }
+
+    m_damage = XDamageCreate(*m_display, DefaultRootWindow(m_display->display()), XDamageReportNonEmpty);
+    m_parts = XFixesCreateRegion(*m_display, nullptr, 0);
+    XFlush(*m_display);
+
+    m_notifier = new QSocketNotifier(ConnectionNumber(m_display->display()), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &X11ScreenDamageTracker::processEvents);
+
+    // Events may have been read into the Xlib queue while creating the damage object.
+    processEvents();
+}
+
+void X11ScreenDamageTracker::stop() {
+    if (m_notifier == nullptr) {
+        return;
+    }
+
+    delete m_notifier;
+    m_notifier = nullptr;
+
+    XDamageDestroy(*m_display, m_damage);
+    XFixesDestroyRegion(*m_display, m_parts);
+    XFlush(*m_display);
+
+    m_damage = None;
+    m_parts = None;
+}
+
+void X11ScreenDamageTracker::setWatchRect(const QRect& rect) {
+    m_watchRect = rect;
+}
+
+void X11ScreenDamageTracker::processEvents() {
+    bool watchedDamage = false;
+
+    while (XPending(*m_display) > 0) {
+        XEvent event;
+        XNextEvent(*m_display, &event);
+
+        if (event.type == m_damageEventBase + XDamageNotify) {
+            // Move the accumulated damage into the parts region. This clears the damage so that the server sends
+            // another notification the next time the screen changes.
+            XDamageSubtract(*m_display, m_damage, None, m_parts);
+
+            int numRects = 0;
+            XRectangle* rects = XFixesFetchRegion(*m_display, m_parts, &numRects);
+            for (int i = 0; i < numRects && !watchedDamage; i++) {
+                const XRectangle& rect = rects[i];      // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                watchedDamage = m_watchRect.intersects(QRect(rect.x, rect.y, rect.width, rect.height));
+            }
+            if (rects != nullptr) {
+                XFree(rects);
+            }
+        }
+    }
+
+    if (watchedDamage) {
+        emit damaged();
+    }
+}
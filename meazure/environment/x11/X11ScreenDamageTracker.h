@@ -0,0 +1,71 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <meazure/environment/ScreenDamageTracker.h>
+#include <QObject>
+#include <QRect>
+#include <QSocketNotifier>
+
+
+namespace Xlib {
+    class Display;
+}
+
+
+/// Tracks changes to the contents of an area of the screen using the X Damage extension. A damage object is created
+/// on the root window in "non-empty" report mode so that the X server sends a single event when the screen contents
+/// change. The accumulated damage is then fetched and cleared, which rearms the event. Events are read from a
+/// dedicated display connection on the GUI thread using a socket notifier, so no polling is performed while the
+/// screen is static.
+///
+class X11ScreenDamageTracker : public QObject, public ScreenDamageTracker {
+
+    Q_OBJECT
+    Q_INTERFACES(ScreenDamageTracker)
+
+public:
+    explicit X11ScreenDamageTracker(QObject* parent = nullptr);
+    ~X11ScreenDamageTracker() override;
+
+    X11ScreenDamageTracker(const X11ScreenDamageTracker&) = delete;
+    X11ScreenDamageTracker(X11ScreenDamageTracker&&) = delete;
+    X11ScreenDamageTracker& operator=(const X11ScreenDamageTracker&) = delete;
+
+    [[nodiscard]] bool isSupported() const override;
+
+    void start() override;
+    void stop() override;
+
+    void setWatchRect(const QRect& rect) override;
+
+signals:
+    void damaged() override;
+
+private slots:
+    void processEvents();
+
+private:
+    Xlib::Display* m_display;
+    int m_damageEventBase { 0 };
+    bool m_supported { false };
+    unsigned long m_damage { 0 };       ///< X Damage object on the root window
+    unsigned long m_parts { 0 };        ///< XFixes region receiving the accumulated damage
+    QSocketNotifier* m_notifier { nullptr };
+    QRect m_watchRect;
+};
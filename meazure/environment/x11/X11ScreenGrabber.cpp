@@ -0,0 +1,263 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "X11ScreenGrabber.h"
+#include <meazure/utils/x11/XcbUtils.h>
+#include <QtGlobal>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+
+
+/// A shared memory segment attached to both this process and the X server.
+///
+struct X11ScreenGrabber::Segment {
+    int shmId;                  ///< System V shared memory identifier
+    xcb_shm_seg_t seg;          ///< X server identifier for the segment
+    uchar* data;                ///< Segment memory mapped into this process
+    std::size_t size;           ///< Size of the segment, in bytes
+    QImage image;               ///< Most recent image wrapping the segment memory
+    bool released { false };    ///< Segment is no longer used by the grabber
+};
+
+
+X11ScreenGrabber::X11ScreenGrabber() : m_conn(Xcb::qtConnection()) {
+    m_supported = probe();
+}
+
+X11ScreenGrabber::~X11ScreenGrabber() {
+    for (Segment* segment : m_segments) {
+        releaseSegment(segment);
+    }
+}
+
+bool X11ScreenGrabber::isSupported() const {
+    return m_supported;
+}
+
+bool X11ScreenGrabber::probe() {
+    // Sending a request for an extension the server does not have shuts down the connection, so check for the
+    // extension before issuing any shared memory requests.
+    const xcb_query_extension_reply_t* extension = xcb_get_extension_data(m_conn, &xcb_shm_id);
+    if (extension == nullptr || extension->present == 0) {
+        return false;
+    }
+
+    try {
+        Xcb::ShmQueryVersion version(m_conn);
+        if (version->major_version < 1) {
+            return false;
+        }
+    } catch (const Xcb::XcbException&) {
+        return false;
+    }
+
+    // The segment memory is wrapped directly by a QImage, so the root window must use a 32 bits per pixel
+    // xRGB format in the host byte order.
+    const xcb_setup_t* setup = xcb_get_setup(m_conn);
+    const xcb_screen_t* screen = xcb_setup_roots_iterator(setup).data;
+
+    const xcb_image_order_t hostOrder = (Q_BYTE_ORDER == Q_LITTLE_ENDIAN) ? XCB_IMAGE_ORDER_LSB_FIRST
+                                                                          : XCB_IMAGE_ORDER_MSB_FIRST;
+    if (setup->image_byte_order != hostOrder) {
+        return false;
+    }
+
+    bool formatOk = false;
+    for (xcb_format_iterator_t format = xcb_setup_pixmap_formats_iterator(setup); format.rem > 0;
+         xcb_format_next(&format)) {
+        if (format.data->depth == screen->root_depth) {
+            formatOk = (format.data->bits_per_pixel == 32);
+            break;
+        }
+    }
+
+    bool visualOk = false;
+    for (xcb_depth_iterator_t depth = xcb_screen_allowed_depths_iterator(screen); depth.rem > 0;
+         xcb_depth_next(&depth)) {
+        for (xcb_visualtype_iterator_t visual = xcb_depth_visuals_iterator(depth.data); visual.rem > 0;
+             xcb_visualtype_next(&visual)) {
+            if (visual.data->visual_id == screen->root_visual) {
+                visualOk = (visual.data->red_mask == 0xff0000)
+                        && (visual.data->green_mask == 0x00ff00)
+                        && (visual.data->blue_mask == 0x0000ff);
+            }
+        }
+    }
+
+    if (!formatOk || !visualOk) {
+        return false;
+    }
+
+    m_root = screen->root;
+    m_rootRect = QRect(0, 0, screen->width_in_pixels, screen->height_in_pixels);
+
+    // The extension is reported even when the X server is on a different host, in which case attaching a segment
+    // fails. Attach a small segment to find out. It is kept for use by the first small grab.
+    Segment* segment = createSegment(static_cast<std::size_t>(sysconf(_SC_PAGESIZE)));
+    if (segment == nullptr) {
+        return false;
+    }
+    m_segments.push_back(segment);
+
+    return true;
+}
+
+QImage X11ScreenGrabber::grab(const QRect& rect) {
+    if (!m_supported || rect.isEmpty()) {
+        return {};
+    }
+
+    const QMutexLocker locker(&m_mutex);
+
+    if (m_rootRect.contains(rect)) {
+        return grabOnScreen(rect);
+    }
+
+    // The X server only copies images that are entirely on the screen. Grab the portion of the rectangle that is
+    // on the screen and place it in an image of the requested size. The off screen portion of the image is black.
+    QImage image(rect.size(), QImage::Format_RGB32);
+    image.fill(Qt::black);
+
+    const QRect onScreenRect = rect.intersected(m_rootRect);
+    if (!onScreenRect.isEmpty()) {
+        const QImage onScreenImage = grabOnScreen(onScreenRect);
+        if (onScreenImage.isNull()) {
+            return {};
+        }
+
+        const QPoint offset = onScreenRect.topLeft() - rect.topLeft();
+        const auto rowBytes = static_cast<std::size_t>(onScreenImage.width()) * 4;
+        for (int y = 0; y < onScreenImage.height(); y++) {
+            std::memcpy(image.scanLine(offset.y() + y) + offset.x() * 4,   // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        onScreenImage.constScanLine(y), rowBytes);
+        }
+    }
+
+    return image;
+}
+
+QImage X11ScreenGrabber::grabOnScreen(const QRect& rect) {
+    const int bytesPerLine = rect.width() * 4;
+    const std::size_t size = static_cast<std::size_t>(bytesPerLine) * rect.height();
+
+    Segment* segment = acquireSegment(size);
+    if (segment == nullptr) {
+        return {};
+    }
+
+    try {
+        Xcb::ShmGetImage image(m_conn, m_root, static_cast<int16_t>(rect.x()), static_cast<int16_t>(rect.y()),
+                               static_cast<uint16_t>(rect.width()), static_cast<uint16_t>(rect.height()),
+                               segment->seg, 0);
+        if (image->depth == 0) {
+            return {};
+        }
+    } catch (const Xcb::XcbException&) {
+        return {};
+    }
+
+    segment->image = QImage(segment->data, rect.width(), rect.height(), bytesPerLine, QImage::Format_RGB32,
+                            unmapSegment, segment);
+    return segment->image;
+}
+
+X11ScreenGrabber::Segment* X11ScreenGrabber::acquireSegment(std::size_t size) {
+    // A segment can be reused once the image wrapping it is only referenced by the grabber. Segments that are free
+    // but too small are replaced by a larger segment.
+    for (auto iter = m_segments.begin(); iter != m_segments.end(); ++iter) {
+        Segment* segment = *iter;
+        if (segment->image.isNull() || segment->image.isDetached()) {
+            segment->image = QImage();
+
+            if (segment->size >= size) {
+                return segment;
+            }
+
+            releaseSegment(segment);
+            m_segments.erase(iter);
+            break;
+        }
+    }
+
+    Segment* segment = createSegment(size);
+    if (segment != nullptr) {
+        m_segments.push_back(segment);
+    }
+    return segment;
+}
+
+X11ScreenGrabber::Segment* X11ScreenGrabber::createSegment(std::size_t size) {
+    const int shmId = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (shmId == -1) {
+        qWarning("Could not create shared memory segment: %s", strerror(errno));    // NOLINT(concurrency-mt-unsafe)
+        return nullptr;
+    }
+
+    void* data = shmat(shmId, nullptr, 0);
+    if (data == reinterpret_cast<void*>(-1)) {      // NOLINT(performance-no-int-to-ptr)
+        qWarning("Could not attach shared memory segment: %s", strerror(errno));    // NOLINT(concurrency-mt-unsafe)
+        shmctl(shmId, IPC_RMID, nullptr);
+        return nullptr;
+    }
+
+    const xcb_shm_seg_t seg = xcb_generate_id(m_conn);
+    xcb_generic_error_t* error = xcb_request_check(m_conn, xcb_shm_attach_checked(m_conn, seg, shmId, 0));
+
+    // Marking the segment for removal once it has been attached by both sides ensures that the system frees it when
+    // the last attachment goes away, even if Meazure terminates abnormally.
+    shmctl(shmId, IPC_RMID, nullptr);
+
+    if (error != nullptr) {
+        std::free(error);       // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+        shmdt(data);
+        return nullptr;
+    }
+
+    return new Segment { shmId, seg, static_cast<uchar*>(data), size, QImage(), false };
+}
+
+void X11ScreenGrabber::releaseSegment(Segment* segment) {
+    xcb_shm_detach(m_conn, segment->seg);
+    xcb_flush(m_conn);
+
+    if (segment->image.isNull()) {
+        shmdt(segment->data);
+        delete segment;
+        return;
+    }
+
+    // The memory is unmapped once the last image wrapping it is destroyed. That happens when the grabber's reference
+    // is dropped below, unless the image is still held outside the grabber, in which case the memory remains mapped
+    // until the holder destroys the image. The segment must not be used once the grabber's reference is dropped.
+    segment->released = true;
+    QImage image;
+    image.swap(segment->image);
+}
+
+void X11ScreenGrabber::unmapSegment(void* info) {
+    auto* segment = static_cast<Segment*>(info);
+
+    // Images wrapping a segment that is still in use by the grabber are destroyed whenever the segment is reused.
+    if (segment->released) {
+        shmdt(segment->data);
+        delete segment;
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QMutex>
+#include <xcb/xcb.h>
+#include <xcb/shm.h>
+#include <vector>
+#include <cstddef>
+
+
+/// Grabs the contents of the screen using the MIT Shared Memory (MIT-SHM) extension. The X server copies the pixels
+/// directly into a shared memory segment, which is then wrapped in a QImage without copying. This avoids transferring
+/// the pixels over the X connection and avoids any format conversion. Segments are kept for the life of the grabber
+/// and reused for subsequent grabs.
+///
+/// A segment is only reused once the image previously wrapped around it is no longer referenced outside the
+/// grabber. Therefore, an image returned by the grabber remains valid for as long as it is held by the caller. If the
+/// grabber is destroyed while an image is still held, the segment memory is unmapped once the image is destroyed.
+///
+/// Shared memory is not available when the X server is on another host (e.g. remote X over ssh). In that case,
+/// isSupported() returns false and the caller is expected to fall back to a conventional screen grab.
+///
+/// The grabber may be used from any thread.
+///
+class X11ScreenGrabber {
+
+public:
+    X11ScreenGrabber();
+    ~X11ScreenGrabber();
+
+    X11ScreenGrabber(const X11ScreenGrabber&) = delete;
+    X11ScreenGrabber(X11ScreenGrabber&&) = delete;
+    X11ScreenGrabber& operator=(const X11ScreenGrabber&) = delete;
+
+    /// Indicates whether shared memory screen grabbing can be used with the X server.
+    ///
+    /// @return true if the X server supports the MIT-SHM extension, is on the local host and uses a pixel format
+    ///     that can be wrapped directly by a QImage.
+    ///
+    [[nodiscard]] bool isSupported() const;
+
+    /// Grabs the specified portion of the screen.
+    ///
+    /// @param[in] rect Rectangle to grab, in pixels
+    /// @return Image of the screen contents in the specified rectangle. Any portion of the rectangle that is off the
+    ///     screen is black. A null image is returned if the grab failed, in which case the caller should fall back
+    ///     to a conventional screen grab.
+    ///
+    QImage grab(const QRect& rect);
+
+private:
+    struct Segment;
+
+    bool probe();
+    QImage grabOnScreen(const QRect& rect);
+    Segment* acquireSegment(std::size_t size);
+    Segment* createSegment(std::size_t size);
+    void releaseSegment(Segment* segment);
+    static void unmapSegment(void* info);
+
+    xcb_connection_t* m_conn;
+    xcb_window_t m_root { XCB_WINDOW_NONE };
+    QRect m_rootRect;
+    bool m_supported { false };
+    QMutex m_mutex;
+    std::vector<Segment*> m_segments;
+};
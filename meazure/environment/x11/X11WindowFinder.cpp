@@ -20,6 +20,7 @@
 #include <meazure/graphics/Graphic.h>
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 
 class BaseCommand {
@@ -67,10 +68,33 @@ private:
 };
 
 
-/// Performs the scan for visible top level windows.
+/// Performs the X requests needed to list the children of the root windows and to find the top level client window
+/// within a child.
 ///
 class Finder {
 public:
+    /// A child of a root window.
+    ///
+    struct Child {
+        xcb_window_t window;
+        bool mapped;
+    };
+
+    /// Result of searching a child of a root window for a visible top level client window.
+    ///
+    struct Client {
+        xcb_window_t window { XCB_WINDOW_NONE };        ///< Client window, XCB_WINDOW_NONE if not found
+        std::unique_ptr<BaseCommand> geometry;          ///< Obtains the client geometry relative to the root
+        std::unique_ptr<BaseCommand> frameGeometry;     ///< Obtains the child geometry if different from the client
+    };
+
+    /// A child of a root window to search for a top level client window.
+    ///
+    struct Search {
+        xcb_window_t root;
+        xcb_window_t child;
+    };
+
     Finder() :
             m_setup(xcb_get_setup(m_conn)),
             m_wmStateAtom(m_conn, false, "WM_STATE"),
@@ -78,74 +102,35 @@ public:
             m_netWMStateHiddenAtom(m_conn, false, "_NET_WM_STATE_HIDDEN") {
     }
 
-    std::vector<QRect> scan() {
-        Commands commands;
+    std::vector<xcb_window_t> roots() {
+        std::vector<xcb_window_t> rootWindows;
         for (xcb_screen_iterator_t screen = xcb_setup_roots_iterator(m_setup); screen.rem > 0; xcb_screen_next(&screen)) {
-            processRootWindow(screen.data->root, commands);
+            rootWindows.push_back(screen.data->root);
         }
-
-        // X reports windows from the bottom to the top. We want the windows reported from top to bottom. Therefore,
-        // traverse the commands backwards to generate the window rectangles.
-        std::vector<QRect> windows;
-        windows.reserve(commands.size());
-        std::for_each(commands.rbegin(), commands.rend(), [&windows](const auto& command) {
-            windows.emplace_back(command->x(), command->y(), command->width(), command->height());
-        });
-
-        return windows;
+        return rootWindows;
     }
 
-private:
-    using Commands = std::vector<std::unique_ptr<BaseCommand>>;
+    /// Lists the children of the specified root window from the bottom of the stack to the top.
+    ///
+    std::vector<Child> children(xcb_window_t root) {
+        Xcb::QueryTree tree(m_conn, root);
+        const xcb_window_t* children = tree.children();
+        const int numChildren = tree.numChildren();
 
-    bool hasWMState(xcb_window_t win) {
-        Xcb::Property prop(m_conn, false, win, m_wmStateAtom, XCB_GET_PROPERTY_TYPE_ANY, 0, 0);
-        return prop->type != XCB_ATOM_NONE;
-    }
+        std::vector<Xcb::Attributes> attrs;
+        attrs.reserve(numChildren);
 
-    bool isHidden(xcb_window_t win) {
-        Xcb::Property state(m_conn, false, win, m_netWMStateAtom, XCB_ATOM_ATOM, 0, 1024);
-        if (state->type == XCB_ATOM_ATOM) {
-            const int len = state.length();
-            const xcb_atom_t* values = static_cast<xcb_atom_t*>(state.value());
-            for (int i = 0; i < len; i++) {
-                if (values[i] == m_netWMStateHiddenAtom) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-                    return true;
-                }
-            }
+        for (int i = 0; i < numChildren; i++) {
+            attrs.emplace_back(m_conn, children[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        return false;
-    }
-
-    bool isViewable(xcb_window_t win, Xcb::Attributes& attrs) {
-        return (attrs->_class == XCB_WINDOW_CLASS_INPUT_OUTPUT)
-                && (attrs->map_state == XCB_MAP_STATE_VIEWABLE)
-                && !isHidden(win);
-    }
-
-    bool processChildWindow(xcb_window_t root, xcb_window_t parent, Commands& commands) {
-        Xcb::QueryTree tree(m_conn, parent);
-        const xcb_window_t* children = tree.children();
-        const int numChildren = tree.numChildren();
+        std::vector<Child> result;
+        result.reserve(numChildren);
 
         for (int i = 0; i < numChildren; i++) {
             const xcb_window_t child = children[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
             try {
-                Xcb::Attributes attrs(m_conn, child);
-
-                // Top level windows have WM_STATE set on them.
-                if (isViewable(child, attrs) && hasWMState(child)) {
-                    // Exclude our own graphic element windows (e.g. crosshair, lines, rectangles)
-                    if (!Graphic::isGraphicWindow(child)) {
-                        commands.emplace_back(new TranslatedGeometryCommand(m_conn, root, child, 0, 0));
-                    }
-                    return true;
-                }
-
-                if (processChildWindow(root, child, commands)) {
-                    return true;
-                }
+                result.push_back({ child, attrs.at(i)->map_state != XCB_MAP_STATE_UNMAPPED });
             } catch (const Xcb::XcbException& ex) {
                 // Ignore BadWindow exceptions
                 if (ex.getErrorCode() != XCB_WINDOW) {
@@ -154,43 +139,190 @@ private:
             }
         }
 
-        return false;
+        return result;
     }
 
-    void processRootWindow(xcb_window_t root, Commands& commands) {
-        Xcb::QueryTree tree(m_conn, root);
-        const xcb_window_t* children = tree.children();
-        const int numChildren = tree.numChildren();
+    /// Searches the specified children of the root windows for visible top level client windows. Top level client
+    /// windows have the WM_STATE property set on them. A child of a root window may itself be the client window,
+    /// or it may be a window manager frame containing the client window at some depth.
+    ///
+    /// The window trees are searched breadth first across all children at once. All requests for the windows at
+    /// one depth are sent before any of their replies are read, so the search takes a few round trips per level of
+    /// the window trees rather than several round trips per window. The requests for the geometry of the client
+    /// windows that are found are sent but their replies are not read, so that they too are pipelined.
+    ///
+    /// The client found is the same as a depth first search would find. That is, if a frame contains more than one
+    /// client window, the first one in depth first order is used, rather than the shallowest one. Within a frame,
+    /// windows that are hidden but mapped are searched. Unmapped and input only windows are not searched because
+    /// they cannot contain a visible client window.
+    ///
+    /// @param[in] searches Children of the root windows to search
+    /// @return Client window found for each search, in the same order as the searches.
+    ///
+    std::vector<Client> findClients(const std::vector<Search>& searches) {
+        std::vector<Client> clients(searches.size());
+        std::vector<Path> clientPaths(searches.size());
+
+        // A window whose path follows that of the client already found for its search, in depth first order, cannot
+        // contain the client that a depth first search would find. Its path cannot be a prefix of the client path
+        // because client windows are not searched.
+        const auto isPreceded = [&clients, &clientPaths](const Node& node) {
+            return clients[node.search].window != XCB_WINDOW_NONE && clientPaths[node.search] < node.path;
+        };
+
+        std::vector<Node> level;
+        level.reserve(searches.size());
+        for (std::size_t i = 0; i < searches.size(); i++) {
+            level.push_back({ i, searches[i].child, Path() });
+        }
 
-        std::vector<Xcb::Attributes> attrs;
-        attrs.reserve(numChildren);
+        while (!level.empty()) {
+            // Send the attribute and state requests for every window at this level.
+            std::vector<Probe> probes;
+            probes.reserve(level.size());
+            for (const Node& node : level) {
+                probes.push_back({ Xcb::Attributes(m_conn, node.window),
+                                   Xcb::Property(m_conn, false, node.window, m_wmStateAtom,
+                                                 XCB_GET_PROPERTY_TYPE_ANY, 0, 0),
+                                   Xcb::Property(m_conn, false, node.window, m_netWMStateAtom, XCB_ATOM_ATOM,
+                                                 0, 1024) });
+            }
 
-        for (int i = 0; i < numChildren; i++) {
-            attrs.emplace_back(m_conn, children[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        }
+            // Read the replies. Visible windows with WM_STATE are clients. The children of other windows that can
+            // contain a client are requested for searching at the next level. All replies are read even if they are
+            // not needed so that they do not accumulate in the connection.
+            std::vector<std::pair<std::size_t, Xcb::QueryTree>> trees;
+            for (std::size_t i = 0; i < level.size(); i++) {
+                const Node& node = level[i];
+                const Search& search = searches[node.search];
+                Probe& probe = probes[i];
+
+                try {
+                    const bool viewable = isViewable(probe);
+                    const bool hasWMState = probe.wmState->type != XCB_ATOM_NONE;
+                    if (isPreceded(node)) {
+                        continue;
+                    }
 
-        for (int i = 0; i < numChildren; i++) {
-            const xcb_window_t child = children[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            try {
-                // Only report on visible windows.
-                if (isViewable(child, attrs.at(i))) {
-                    // Top level windows have WM_STATE set on them.
-                    if (hasWMState(child)) {
-                        // Exclude our own graphic element windows (e.g. crosshair, lines, rectangles)
-                        if (!Graphic::isGraphicWindow(child)) {
-                            commands.emplace_back(new GeometryCommand(m_conn, child));
+                    if (node.path.empty() && !viewable) {
+                        continue;
+                    }
+
+                    if (!viewable || !hasWMState) {
+                        if (canContainClient(probe)) {
+                            trees.emplace_back(i, Xcb::QueryTree(m_conn, node.window));
                         }
+                        continue;
+                    }
+
+                    // Replacing a client found at a shallower level discards its pending geometry requests.
+                    Client& client = clients[node.search];
+                    client = Client();
+                    client.window = node.window;
+                    clientPaths[node.search] = node.path;
+
+                    // Exclude our own graphic element windows (e.g. crosshair, lines, rectangles)
+                    if (Graphic::isGraphicWindow(node.window)) {
+                        continue;
+                    }
+
+                    if (node.path.empty()) {
+                        client.geometry = std::make_unique<GeometryCommand>(m_conn, node.window);
                     } else {
-                        processChildWindow(root, child, commands);
+                        client.geometry = std::make_unique<TranslatedGeometryCommand>(m_conn, search.root,
+                                                                                      node.window, 0, 0);
+                        client.frameGeometry = std::make_unique<GeometryCommand>(m_conn, search.child);
+                    }
+                } catch (const Xcb::XcbException& ex) {
+                    // Ignore BadWindow exceptions
+                    if (ex.getErrorCode() != XCB_WINDOW) {
+                        throw;
                     }
                 }
-            } catch (const Xcb::XcbException& ex) {
-                // Ignore BadWindow exceptions
-                if (ex.getErrorCode() != XCB_WINDOW) {
-                    throw;
+            }
+
+            // Read the children for the next level. Windows that follow a client found at this level, in depth
+            // first order, are not searched further.
+            std::vector<Node> nextLevel;
+            for (auto& [index, tree] : trees) {
+                const Node& node = level[index];
+                try {
+                    const xcb_window_t* children = tree.children();
+                    const int numChildren = tree.numChildren();
+                    if (isPreceded(node)) {
+                        continue;
+                    }
+
+                    for (int i = 0; i < numChildren; i++) {
+                        Path path = node.path;
+                        path.push_back(i);
+                        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        nextLevel.push_back({ node.search, children[i], std::move(path) });
+                    }
+                } catch (const Xcb::XcbException& ex) {
+                    // Ignore BadWindow exceptions
+                    if (ex.getErrorCode() != XCB_WINDOW) {
+                        throw;
+                    }
                 }
             }
+
+            level = std::move(nextLevel);
         }
+
+        return clients;
+    }
+
+private:
+    /// Location of a window below the child of a root window, as the index of each window among its siblings
+    /// starting from the child of the root window. Paths compare in depth first search order.
+    ///
+    using Path = std::vector<int>;
+
+    /// A window being searched.
+    ///
+    struct Node {
+        std::size_t search;         ///< Index of the search to which the window belongs
+        xcb_window_t window;
+        Path path;                  ///< Location of the window below the child of the root window
+    };
+
+    /// Requests for the information needed to determine whether a window is a visible top level client window.
+    ///
+    struct Probe {
+        Xcb::Attributes attrs;
+        Xcb::Property wmState;
+        Xcb::Property netWMState;
+    };
+
+    bool isHidden(Probe& probe) {
+        Xcb::Property& state = probe.netWMState;
+        if (state->type == XCB_ATOM_ATOM) {
+            const int len = state.length();
+            const xcb_atom_t* values = static_cast<xcb_atom_t*>(state.value());
+            for (int i = 0; i < len; i++) {
+                if (values[i] == m_netWMStateHiddenAtom) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    static bool canContainClient(Probe& probe) {
+        // The descendants of an unmapped window are not viewable, and an input only window can only have input only
+        // descendants.
+        return (probe.attrs->_class == XCB_WINDOW_CLASS_INPUT_OUTPUT)
+                && (probe.attrs->map_state == XCB_MAP_STATE_VIEWABLE);
+    }
+
+    bool isViewable(Probe& probe) {
+        // All replies are read, rather than short circuiting, so that none are left in the connection.
+        const bool hidden = isHidden(probe);
+        return (probe.attrs->_class == XCB_WINDOW_CLASS_INPUT_OUTPUT)
+                && (probe.attrs->map_state == XCB_MAP_STATE_VIEWABLE)
+                && !hidden;
     }
 
 
@@ -214,20 +346,286 @@ bool X11WindowFinder::isSupported() const {
 }
 
 void X11WindowFinder::refresh() {
-    m_firstUpdate = true;
-    m_windows = m_updater->scan();
+    m_stacks.clear();
+
+    for (const xcb_window_t root : m_updater->roots()) {
+        Stack& stack = m_stacks.emplace_back();
+        stack.root = root;
+
+        for (const Finder::Child& child : m_updater->children(root)) {
+            Entry& entry = stack.entries.emplace_back();
+            entry.window = child.window;
+            entry.mapped = child.mapped;
+        }
+    }
+
+    m_scanned = true;
+    m_indexed = false;
+}
+
+void X11WindowFinder::update(const WindowEvent& event) {
+    // Events received before the first scan are already reflected in the scan.
+    if (!m_scanned) {
+        return;
+    }
+
+    m_indexed = false;
+
+    Stack* stack = nullptr;
+    Entry* entry = findEntry(event.window, &stack);
+
+    switch (event.type) {
+        case WindowEvent::Created:
+            // New windows are placed at the top of the stack.
+            if (entry == nullptr) {
+                stack = findStack(event.parent);
+                if (stack != nullptr) {
+                    Entry& newEntry = stack->entries.emplace_back();
+                    newEntry.window = event.window;
+                    newEntry.frame = QRect(event.x, event.y, event.width, event.height);
+                }
+            }
+            break;
+        case WindowEvent::Destroyed:
+            if (entry != nullptr) {
+                removeEntry(event.window);
+            } else {
+                invalidateClient(event.window);
+            }
+            break;
+        case WindowEvent::Mapped:
+            if (entry != nullptr) {
+                entry->mapped = true;
+                entry->resolved = false;
+            } else {
+                // A window within a child has been mapped, which may be the child's client window. The ancestry of
+                // the window is not known, so children without a client window are searched again.
+                invalidateClient(event.window);
+                for (Stack& s : m_stacks) {
+                    for (Entry& e : s.entries) {
+                        if (e.mapped && e.client == 0) {
+                            e.resolved = false;
+                        }
+                    }
+                }
+            }
+            break;
+        case WindowEvent::Unmapped:
+            if (entry != nullptr) {
+                entry->mapped = false;
+            } else {
+                invalidateClient(event.window);
+            }
+            break;
+        case WindowEvent::Configured:
+            if (entry != nullptr) {
+                const QRect frame(event.x, event.y, event.width, event.height);
+
+                // Moving a child moves its client window by the same amount. Any other change requires the client
+                // window geometry to be obtained again.
+                if (entry->resolved && entry->frame.isValid() && entry->frame.size() == frame.size()) {
+                    entry->rect.translate(frame.topLeft() - entry->frame.topLeft());
+                } else {
+                    entry->resolved = false;
+                }
+                entry->frame = frame;
+
+                restack(*stack, event.window, event.sibling);
+            } else {
+                invalidateClient(event.window);
+            }
+            break;
+        case WindowEvent::Reparented: {
+            Stack* newStack = findStack(event.parent);
+            if (entry != nullptr && newStack == nullptr) {
+                // The window is no longer a child of a root window (e.g. it has been placed in a frame by the
+                // window manager).
+                removeEntry(event.window);
+            } else if (entry == nullptr && newStack != nullptr) {
+                // The window has become a child of a root window (e.g. the window manager has released it). Its
+                // visibility is determined when it is resolved.
+                Entry& newEntry = newStack->entries.emplace_back();
+                newEntry.window = event.window;
+                newEntry.mapped = true;
+            }
+
+            invalidateClient(event.window);
+            Entry* parentEntry = findEntry(event.parent);
+            if (parentEntry != nullptr) {
+                parentEntry->resolved = false;
+            }
+            break;
+        }
+        case WindowEvent::Circulated:
+            if (entry != nullptr) {
+                auto& entries = stack->entries;
+                auto iter = std::find_if(entries.begin(), entries.end(),
+                                         [&event](const Entry& e) { return e.window == event.window; });
+                if (event.onTop) {
+                    std::rotate(iter, iter + 1, entries.end());
+                } else {
+                    std::rotate(entries.begin(), iter, iter + 1);
+                }
+            }
+            break;
+    }
 }
 
 QRect X11WindowFinder::find(const QPoint& position) {
-    if (!m_firstUpdate) {
+    if (!m_scanned) {
         refresh();
     }
 
-    for (const QRect& winRect : m_windows) {
-        if (winRect.contains(position, false)) {
-            return winRect;
+    // Entries can only become unresolved by a refresh or an update, both of which invalidate the index. Between
+    // window changes, finding a window is therefore only an index lookup.
+    if (!m_indexed) {
+        try {
+            resolve();
+        } catch (const Xcb::XcbException&) {
+            // The window list may no longer reflect the screen, so start over.
+            refresh();
+            resolve();
+        }
+
+        buildIndex();
+    }
+
+    const int index = m_index.find(position);
+    return (index == -1) ? QRect() : m_index.at(index);
+}
+
+void X11WindowFinder::buildIndex() {
+    // X reports windows from the bottom to the top. The index requires the windows from top to bottom. Therefore,
+    // traverse the stacks backwards.
+    std::vector<QRect> rects;
+    for (auto stack = m_stacks.rbegin(); stack != m_stacks.rend(); ++stack) {
+        for (auto entry = stack->entries.rbegin(); entry != stack->entries.rend(); ++entry) {
+            if (entry->mapped && !entry->rect.isEmpty()) {
+                rects.push_back(entry->rect);
+            }
+        }
+    }
+
+    m_index.build(std::move(rects));
+    m_indexed = true;
+}
+
+void X11WindowFinder::resolve() {
+    std::vector<Entry*> entries;
+    std::vector<Finder::Search> searches;
+
+    for (Stack& stack : m_stacks) {
+        for (Entry& entry : stack.entries) {
+            if (entry.mapped && !entry.resolved) {
+                entries.push_back(&entry);
+                searches.push_back({ static_cast<xcb_window_t>(stack.root), static_cast<xcb_window_t>(entry.window) });
+            }
+        }
+    }
+
+    if (searches.empty()) {
+        return;
+    }
+
+    std::vector<Finder::Client> clients = m_updater->findClients(searches);
+
+    // The geometry requests for all clients have been sent. Read the replies.
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        Entry* entry = entries[i];
+        Finder::Client& client = clients[i];
+        entry->client = client.window;
+        entry->rect = QRect();
+
+        try {
+            if (client.geometry) {
+                BaseCommand& geom = *client.geometry;
+                entry->rect = QRect(geom.x(), geom.y(), geom.width(), geom.height());
+                entry->frame = entry->rect;
+            }
+            if (client.frameGeometry) {
+                BaseCommand& geom = *client.frameGeometry;
+                entry->frame = QRect(geom.x(), geom.y(), geom.width(), geom.height());
+            }
+        } catch (const Xcb::XcbException& ex) {
+            // Ignore BadWindow exceptions. The window is being destroyed.
+            if (ex.getErrorCode() != XCB_WINDOW) {
+                throw;
+            }
+            entry->rect = QRect();
+        }
+
+        entry->resolved = true;
+    }
+}
+
+X11WindowFinder::Entry* X11WindowFinder::findEntry(unsigned long window, Stack** stack) {
+    for (Stack& s : m_stacks) {
+        for (Entry& entry : s.entries) {
+            if (entry.window == window) {
+                if (stack != nullptr) {
+                    *stack = &s;
+                }
+                return &entry;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+X11WindowFinder::Stack* X11WindowFinder::findStack(unsigned long root) {
+    for (Stack& stack : m_stacks) {
+        if (stack.root == root) {
+            return &stack;
+        }
+    }
+
+    return nullptr;
+}
+
+void X11WindowFinder::removeEntry(unsigned long window) {
+    for (Stack& stack : m_stacks) {
+        auto& entries = stack.entries;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [window](const Entry& entry) { return entry.window == window; }),
+                      entries.end());
+    }
+}
+
+void X11WindowFinder::invalidateClient(unsigned long window) {
+    for (Stack& stack : m_stacks) {
+        for (Entry& entry : stack.entries) {
+            if (entry.client == window) {
+                entry.resolved = false;
+            }
+        }
+    }
+}
+
+void X11WindowFinder::restack(Stack& stack, unsigned long window, unsigned long sibling) {
+    auto& entries = stack.entries;
+    auto iter = std::find_if(entries.begin(), entries.end(),
+                             [window](const Entry& entry) { return entry.window == window; });
+    if (iter == entries.end()) {
+        return;
+    }
+
+    const auto index = iter - entries.begin();
+    const Entry entry = *iter;
+    entries.erase(iter);
+
+    // A window without a sibling is at the bottom of the stack. Otherwise, it is directly above the sibling. If the
+    // sibling is not known, the window is left where it was.
+    auto position = entries.begin();
+    if (sibling != 0) {
+        position = std::find_if(entries.begin(), entries.end(),
+                                [sibling](const Entry& e) { return e.window == sibling; });
+        if (position == entries.end()) {
+            position = entries.begin() + index;
+        } else {
+            ++position;
         }
     }
 
-    return {};
+    entries.insert(position, entry);
 }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <meazure/environment/WindowFinder.h>
+#include <meazure/utils/Geometry.h>
 #include <QObject>
 #include <QPoint>
 #include <QRect>
@@ -30,6 +31,14 @@ class Finder;
 /// Finds the geometry of X11 top level client windows on all screens. Windows that are input-only, minimized or are
 /// Meazure graphic elements are not included.
 ///
+/// The children of each root window (typically window manager frames) are kept in stacking order. The list is
+/// obtained by a full scan of the window hierarchy when the finder is refreshed, and is then kept up to date
+/// incrementally using window events. An event only affects the entry for the window concerned. The top level client
+/// window within an entry is only searched for when the entry is first needed after a change that could affect it.
+/// A full scan is performed again if an unexpected error occurs. The client window geometries are kept in a spatial
+/// index, which is rebuilt on the first find following a change, so that finding a window does not depend on the
+/// number of windows.
+///
 class X11WindowFinder : public WindowFinder {
 
 public:
@@ -44,10 +53,40 @@ public:
 
     void refresh() override;
 
+    void update(const WindowEvent& event) override;
+
     QRect find(const QPoint& position) override;
 
 private:
+    /// A child of a root window.
+    ///
+    struct Entry {
+        unsigned long window { 0 };     ///< Child of the root window
+        unsigned long client { 0 };     ///< Top level client window within the child, 0 if none found
+        QRect frame;                    ///< Geometry of the child window, relative to the root window
+        QRect rect;                     ///< Geometry of the client window, empty if there is no visible client window
+        bool mapped { false };          ///< Whether the child window is mapped
+        bool resolved { false };        ///< Whether the client window and its geometry are up to date
+    };
+
+    /// Children of a root window, ordered from the bottom of the stack to the top.
+    ///
+    struct Stack {
+        unsigned long root { 0 };
+        std::vector<Entry> entries;
+    };
+
+    void resolve();
+    void buildIndex();
+    Entry* findEntry(unsigned long window, Stack** stack = nullptr);
+    Stack* findStack(unsigned long root);
+    void removeEntry(unsigned long window);
+    void invalidateClient(unsigned long window);
+    void restack(Stack& stack, unsigned long window, unsigned long sibling);
+
     Finder* m_updater;
-    bool m_firstUpdate { false };
-    std::vector<QRect> m_windows;
+    bool m_scanned { false };
+    std::vector<Stack> m_stacks;
+    Geometry::RectIndex m_index;        ///< Geometry of the visible client windows, from the top of the stack down
+    bool m_indexed { false };           ///< Whether the index reflects the stacks
 };
@@ -20,12 +20,20 @@
 #include <meazure/utils/x11/XlibUtils.h>
 #include <meazure/utils/x11/XRecordUtils.h>
 #include <X11/Xproto.h>
+#include <xcb/xcb.h>
+#include <algorithm>
+#include <memory>
+#include <cstdlib>
 #include <sys/select.h>
 #include <unistd.h>
 #include <fcntl.h>
 
 
 X11WindowTracker::X11WindowTracker(QObject *parent) : QThread(parent) { // NOLINT(cppcoreguidelines-pro-type-member-init)
+    // Allow window events to be passed through queued connections by clients.
+    qRegisterMetaType<WindowEvent>("WindowEvent");
+
+    connect(&m_deliveryPacer, &RefreshPacer::triggered, this, &X11WindowTracker::deliver);
 }
 
 X11WindowTracker::~X11WindowTracker() {
@@ -43,6 +51,9 @@ void X11WindowTracker::start() {
         return;
     }
 
+    // Events are delivered at most once per display refresh.
+    m_deliveryPacer.updateInterval();
+
     // Indicate that the tracking thread should loop.
     m_run = true;
 
@@ -70,9 +81,139 @@ void X11WindowTracker::stop() {
     // Close the pipe used to unblock the tracking thread.
     close(m_stopFd[0]);
     close(m_stopFd[1]);
+
+    // Discard undelivered events. The window finder is refreshed when tracking is restarted.
+    m_deliveryPacer.stop();
+    m_queue.clear();
+    m_deliveryRequested.store(false, std::memory_order_release);
+}
+
+quint64 X11WindowTracker::getReceivedCount() const {
+    return m_receivedCount.load(std::memory_order_relaxed);
+}
+
+quint64 X11WindowTracker::getDeliveredCount() const {
+    return m_deliveredCount.load(std::memory_order_relaxed);
 }
 
 void X11WindowTracker::run() {
+    if (!trackSubstructure()) {
+        trackRecord();
+    }
+}
+
+bool X11WindowTracker::trackSubstructure() {
+    const std::unique_ptr<xcb_connection_t, decltype(&xcb_disconnect)> connection(xcb_connect(nullptr, nullptr),
+                                                                                  xcb_disconnect);
+    if (xcb_connection_has_error(connection.get()) != 0) {
+        return false;
+    }
+
+    // Any number of clients can select the structure notification events of the children of a window, so the
+    // selection only fails if the X server is in an unusual state.
+    const uint32_t eventMask = XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY;
+    std::vector<xcb_void_cookie_t> cookies;
+    for (auto iter = xcb_setup_roots_iterator(xcb_get_setup(connection.get())); iter.rem > 0; xcb_screen_next(&iter)) {
+        cookies.push_back(xcb_change_window_attributes_checked(connection.get(), iter.data->root, XCB_CW_EVENT_MASK,
+                                                               &eventMask));
+    }
+
+    bool selected = !cookies.empty();
+    for (const xcb_void_cookie_t& cookie : cookies) {
+        xcb_generic_error_t* error = xcb_request_check(connection.get(), cookie);
+        if (error != nullptr) {
+            selected = false;
+            std::free(error);       // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+        }
+    }
+    if (!selected) {
+        return false;
+    }
+
+    const int connectionFd = xcb_get_file_descriptor(connection.get());
+
+    while (m_run) {
+        // Events can already have been read into the XCB queue (e.g. while checking the event selection above), and
+        // select only reports data not yet read from the connection. Therefore, drain the queue before waiting.
+        while (xcb_generic_event_t* xevent = xcb_poll_for_event(connection.get())) {
+            WindowEvent event;
+            bool recognized = true;
+
+            switch (xevent->response_type & 0x7F) {
+                case XCB_CREATE_NOTIFY: {
+                    const auto* notify = reinterpret_cast<xcb_create_notify_event_t*>(xevent);
+                    event.type = WindowEvent::Created;
+                    event.window = notify->window;
+                    event.parent = notify->parent;
+                    event.x = notify->x;
+                    event.y = notify->y;
+                    event.width = notify->width;
+                    event.height = notify->height;
+                    break;
+                }
+                case XCB_DESTROY_NOTIFY:
+                    event.type = WindowEvent::Destroyed;
+                    event.window = reinterpret_cast<xcb_destroy_notify_event_t*>(xevent)->window;
+                    break;
+                case XCB_MAP_NOTIFY:
+                    event.type = WindowEvent::Mapped;
+                    event.window = reinterpret_cast<xcb_map_notify_event_t*>(xevent)->window;
+                    break;
+                case XCB_UNMAP_NOTIFY:
+                    event.type = WindowEvent::Unmapped;
+                    event.window = reinterpret_cast<xcb_unmap_notify_event_t*>(xevent)->window;
+                    break;
+                case XCB_REPARENT_NOTIFY: {
+                    const auto* notify = reinterpret_cast<xcb_reparent_notify_event_t*>(xevent);
+                    event.type = WindowEvent::Reparented;
+                    event.window = notify->window;
+                    event.parent = notify->parent;
+                    event.x = notify->x;
+                    event.y = notify->y;
+                    break;
+                }
+                case XCB_CIRCULATE_NOTIFY: {
+                    const auto* notify = reinterpret_cast<xcb_circulate_notify_event_t*>(xevent);
+                    event.type = WindowEvent::Circulated;
+                    event.window = notify->window;
+                    event.onTop = (notify->place == XCB_PLACE_ON_TOP);
+                    break;
+                }
+                case XCB_CONFIGURE_NOTIFY: {
+                    const auto* notify = reinterpret_cast<xcb_configure_notify_event_t*>(xevent);
+                    event.type = WindowEvent::Configured;
+                    event.window = notify->window;
+                    event.sibling = notify->above_sibling;
+                    event.x = notify->x;
+                    event.y = notify->y;
+                    event.width = notify->width;
+                    event.height = notify->height;
+                    break;
+                }
+                default:
+                    recognized = false;
+                    break;
+            }
+
+            std::free(xevent);      // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+
+            if (recognized) {
+                handleEvent(event);
+            }
+        }
+
+        if (xcb_connection_has_error(connection.get()) != 0) {
+            qWarning("Connection used to track windows has failed");
+            break;
+        }
+
+        waitForInput(connectionFd);
+    }
+
+    return true;
+}
+
+void X11WindowTracker::trackRecord() {
     // Two display connections are recommended by the XRecord spec
     // (https://www.x.org/releases/X11R7.6/doc/libXtst/recordlib.html#record_clients). The spec also indicates which
     // display connections should be specified in a given XRecord function call. For example, the control display
@@ -87,8 +228,10 @@ void X11WindowTracker::run() {
         qFatal("XRecord extension not supported on this X Server");
     }
 
+    // The structure notification events are contiguous, from CreateNotify to CirculateNotify. The request events
+    // in that range (e.g. MapRequest) are ignored.
     XRecord::Range range;
-    range.setDeliveredEvent(ConfigureNotify);
+    range.setDeliveredEvents(CreateNotify, CirculateNotify);
 
     const XRecord::Context context(controlDisplay, dataDisplay, 0, XRecordAllClients, 1, range, 1);
 
@@ -96,19 +239,62 @@ void X11WindowTracker::run() {
         auto* instance = reinterpret_cast<X11WindowTracker*>(priv);
 
         if (hook->category == XRecordFromServer) {
-            // The data is formatted as an X Protocol event defined in Xproto.h. For a ConfigureNotify
-            // event, the data is formatted according to the configureNotify structure in the xEvent
-            // union.
-            auto* configureEvent = reinterpret_cast<xEvent*>(hook->data);
-            if (configureEvent->u.u.type == ConfigureNotify) {
-                const Window win = configureEvent->u.configureNotify.window;
-                if (!Graphic::isGraphicWindow(win)) {
-                    instance->handleChange(win,
-                                           configureEvent->u.configureNotify.x,
-                                           configureEvent->u.configureNotify.y,
-                                           configureEvent->u.configureNotify.width,
-                                           configureEvent->u.configureNotify.height);
-                }
+            // The data is formatted as an X Protocol event defined in Xproto.h, according to the structure for the
+            // event type in the xEvent union.
+            auto* xevent = reinterpret_cast<xEvent*>(hook->data);
+            WindowEvent event;
+            bool recognized = true;
+
+            switch (xevent->u.u.type & 0x7F) {
+                case CreateNotify:
+                    event.type = WindowEvent::Created;
+                    event.window = xevent->u.createNotify.window;
+                    event.parent = xevent->u.createNotify.parent;
+                    event.x = xevent->u.createNotify.x;
+                    event.y = xevent->u.createNotify.y;
+                    event.width = xevent->u.createNotify.width;
+                    event.height = xevent->u.createNotify.height;
+                    break;
+                case DestroyNotify:
+                    event.type = WindowEvent::Destroyed;
+                    event.window = xevent->u.destroyNotify.window;
+                    break;
+                case MapNotify:
+                    event.type = WindowEvent::Mapped;
+                    event.window = xevent->u.mapNotify.window;
+                    break;
+                case UnmapNotify:
+                    event.type = WindowEvent::Unmapped;
+                    event.window = xevent->u.unmapNotify.window;
+                    break;
+                case ReparentNotify:
+                    event.type = WindowEvent::Reparented;
+                    event.window = xevent->u.reparent.window;
+                    event.parent = xevent->u.reparent.parent;
+                    event.x = xevent->u.reparent.x;
+                    event.y = xevent->u.reparent.y;
+                    break;
+                case CirculateNotify:
+                    event.type = WindowEvent::Circulated;
+                    event.window = xevent->u.circulate.window;
+                    event.onTop = (xevent->u.circulate.place == PlaceOnTop);
+                    break;
+                case ConfigureNotify:
+                    event.type = WindowEvent::Configured;
+                    event.window = xevent->u.configureNotify.window;
+                    event.sibling = xevent->u.configureNotify.aboveSibling;
+                    event.x = xevent->u.configureNotify.x;
+                    event.y = xevent->u.configureNotify.y;
+                    event.width = xevent->u.configureNotify.width;
+                    event.height = xevent->u.configureNotify.height;
+                    break;
+                default:
+                    recognized = false;
+                    break;
+            }
+
+            if (recognized) {
+                instance->handleEvent(event);
             }
         }
 
@@ -119,26 +305,98 @@ void X11WindowTracker::run() {
 
     const int displayFd = ConnectionNumber(dataDisplay.display());
 
+    while (m_run) {
+        if (waitForInput(displayFd)) {
+            context.processReplies();
+        }
+    }
+}
+
+bool X11WindowTracker::waitForInput(int displayFd) {
+    // The select system call is used to avoid spinning on the display connection, which would needlessly load the
+    // processor. The stop pipe is used to unblock the select so that the state of the run flag can be checked and
+    // the loop can be terminated when stop() is called. This technique for unblocking the select is called the
+    // "self-pipe trick". See http://cr.yp.to/docs/selfpipe.html for the description of this technique created by
+    // D. J. Bernstein.
     const int numFds = std::max(displayFd, m_stopFd[0]) + 1;
     fd_set fds;
 
-    while (m_run) {
-        // The select system call is used to avoid spinning on XRecordProcessReplies, which would needlessly
-        // load the processor. The stop pipe is used to unblock the select so that the state of the run flag
-        // can be checked and the loop can be terminated when stop() is called. This technique for unblocking
-        // the select is called the "self-pipe trick". See http://cr.yp.to/docs/selfpipe.html for the description
-        // of this technique created by D. J. Bernstein.
-        FD_ZERO(&fds);
-        FD_SET(displayFd, &fds);
-        FD_SET(m_stopFd[0], &fds);
-
-        select(numFds, &fds, nullptr, nullptr, nullptr);
-        if (FD_ISSET(displayFd, &fds)) {
-            context.processReplies();
+    FD_ZERO(&fds);
+    FD_SET(displayFd, &fds);
+    FD_SET(m_stopFd[0], &fds);
+
+    select(numFds, &fds, nullptr, nullptr, nullptr);
+    return FD_ISSET(displayFd, &fds);
+}
+
+void X11WindowTracker::handleEvent(const WindowEvent& event) {
+    QueuedEvent queued;
+    queued.event = event;
+    queued.changed = (event.type == WindowEvent::Configured && !Graphic::isGraphicWindow(event.window));
+
+    m_receivedCount.fetch_add(queued.changed ? 2 : 1, std::memory_order_relaxed);
+
+    // The queue is drained by the GUI thread once per display refresh, so it can only fill if the GUI thread is
+    // busy. Wait for room rather than drop the event, which would corrupt the window finder's view of the windows.
+    while (!m_queue.push(queued)) {
+        if (!m_run) {
+            return;
         }
+        msleep(1);
+    }
+
+    // Only one delivery request is queued to the GUI thread at a time.
+    if (!m_deliveryRequested.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, &X11WindowTracker::scheduleDelivery, Qt::QueuedConnection);
     }
 }
 
-void X11WindowTracker::handleChange(unsigned long windowId, int16_t x, int16_t y, uint16_t width, uint16_t height) {
-    emit windowChanged(windowId, x, y, width, height);
+void X11WindowTracker::scheduleDelivery() {
+    // Events following a pause are delivered immediately. Continuous events are delivered once per refresh interval.
+    m_deliveryPacer.schedule();
+}
+
+void X11WindowTracker::deliver() {
+    // Events queued after the request flag is cleared cause another delivery to be requested.
+    m_deliveryRequested.store(false, std::memory_order_release);
+
+    m_events.clear();
+    m_changes.clear();
+    m_changeIndices.clear();
+
+    QueuedEvent queued;
+    while (m_queue.pop(queued)) {
+        const WindowEvent& event = queued.event;
+
+        // A configure event describes the complete geometry and stacking position of a window. Therefore, it
+        // supersedes an immediately preceding configure event for the same window. Configure events separated by
+        // other events are not merged so that the order in which windows are restacked relative to each other is
+        // preserved.
+        if (event.type == WindowEvent::Configured && !m_events.empty() && m_events.back().type == event.type
+                && m_events.back().window == event.window) {
+            m_events.back() = event;
+        } else {
+            m_events.push_back(event);
+        }
+
+        // Only the latest geometry of a window is of interest.
+        if (queued.changed) {
+            const WindowChange change { event.window, event.x, event.y, event.width, event.height };
+            const auto [iter, inserted] = m_changeIndices.try_emplace(event.window, m_changes.size());
+            if (inserted) {
+                m_changes.push_back(change);
+            } else {
+                m_changes[iter->second] = change;
+            }
+        }
+    }
+
+    m_deliveredCount.fetch_add(m_events.size() + m_changes.size(), std::memory_order_relaxed);
+
+    for (const WindowEvent& event : m_events) {
+        emit windowEvent(event);
+    }
+    for (const WindowChange& change : m_changes) {
+        emit windowChanged(change.windowId, change.x, change.y, change.width, change.height);
+    }
 }
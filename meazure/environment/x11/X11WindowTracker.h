@@ -18,15 +18,36 @@
 #pragma once
 
 #include <meazure/environment/WindowTracker.h>
+#include <meazure/utils/SpscQueue.h>
+#include <meazure/utils/RefreshPacer.h>
 #include <QThread>
+#include <QtGlobal>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
 #include <cstdint>
+#include <cstddef>
 
 
-/// Tracks changes to the position and size of all windows on the screen. This is accomplished using the XRecord
-/// extension to capture configure notify events. The code is based on examples at
+/// Tracks changes to the position, size, stacking and visibility of the top level windows on the screen. The
+/// structure notification events of the children of each root window are selected on a dedicated XCB connection.
+/// Only the events of the top level windows are therefore sent by the X server, which is sufficient because the
+/// window finder stacks the top level windows and obtains the geometry of their client windows on demand.
+///
+/// If the events cannot be selected, the XRecord extension is used to capture the structure notification events of
+/// all windows sent to all clients. That code is based on examples at
 /// https://github.com/nibrahim/showkeys/blob/master/tests/record-example.c and
 /// https://github.com/KivApple/qvkbd/blob/master/src/x11support.cpp. Note that Meazure graphics windows (e.g. the
-/// crosshair) are not tracked.
+/// crosshair) are not reported by the windowChanged signal.
+///
+/// The events are read on a tracking thread and passed to the GUI thread through a lock-free single producer, single
+/// consumer queue. Moving or resizing a window interactively generates a flood of events. Rather than queueing a
+/// signal to the GUI thread for each event, the queued events are delivered in a batch on the GUI thread at most
+/// once per display refresh. Only the latest geometry of each window is delivered by the windowChanged signal, and
+/// consecutive configure events for the same window are merged into one windowEvent signal. The first event
+/// following a pause is delivered immediately (leading edge), and events received while a batch is being delayed
+/// are delivered at the end of the refresh interval (trailing edge) so that the final geometry of a window is never
+/// lost. Because the signals are emitted on the thread that owns the tracker, they are not queued.
 ///
 class X11WindowTracker : public QThread, public WindowTracker {
 
@@ -46,6 +67,21 @@ public:
     void start() override;
     void stop() override;
 
+    /// Obtains the number of window events and window changes received from the X server since the tracker was
+    /// constructed.
+    ///
+    /// @return Number of received events.
+    ///
+    [[nodiscard]] quint64 getReceivedCount() const;
+
+    /// Obtains the number of window events and window changes delivered by the windowEvent and windowChanged
+    /// signals since the tracker was constructed. The difference from the received count is the number of events
+    /// eliminated by coalescing.
+    ///
+    /// @return Number of delivered events.
+    ///
+    [[nodiscard]] quint64 getDeliveredCount() const;
+
 signals:
     /// Emitted when a window has changed its location, size or visibility.
     ///
@@ -57,12 +93,54 @@ signals:
     ///
     void windowChanged(unsigned long windowId, int16_t x, int16_t y, uint16_t width, uint16_t height) override;
 
+    /// Emitted when the structure of the window hierarchy has changed.
+    ///
+    /// @param event Describes the change
+    ///
+    void windowEvent(const WindowEvent& event) override;
+
 protected:
     void run() override;
 
+private slots:
+    void scheduleDelivery();
+    void deliver();
+
 private:
-    void handleChange(unsigned long windowId, int16_t x, int16_t y, uint16_t width, uint16_t height);
+    static constexpr std::size_t k_queueCapacity { 2048 };
+
+    /// Latest geometry of a window.
+    ///
+    struct WindowChange {
+        unsigned long windowId;
+        int16_t x;
+        int16_t y;
+        uint16_t width;
+        uint16_t height;
+    };
+
+    /// Event passed from the tracking thread to the GUI thread.
+    ///
+    struct QueuedEvent {
+        WindowEvent event;
+        bool changed { false };         ///< Also report the event using the windowChanged signal
+    };
+
+    bool trackSubstructure();
+    void trackRecord();
+    bool waitForInput(int displayFd);
+    void handleEvent(const WindowEvent& event);
 
     int m_stopFd[2];
     volatile bool m_run { false };
+
+    SpscQueue<QueuedEvent, k_queueCapacity> m_queue;    ///< Written by the tracking thread, read by the GUI thread
+    std::atomic<bool> m_deliveryRequested { false };    ///< A delivery is scheduled or about to be scheduled
+
+    RefreshPacer m_deliveryPacer;                       ///< Paces delivery to the display refresh
+    std::vector<WindowEvent> m_events;                  ///< Events being delivered, reused to avoid allocation
+    std::vector<WindowChange> m_changes;                ///< Changes being delivered, reused to avoid allocation
+    std::unordered_map<unsigned long, std::size_t> m_changeIndices;     ///< Window ID to m_changes index
+    std::atomic<quint64> m_receivedCount { 0 };
+    std::atomic<quint64> m_deliveredCount { 0 };
 };
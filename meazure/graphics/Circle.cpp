@@ -38,7 +38,7 @@ Circle::Circle(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider,
     connect(Dimensions::getChangeNotifier(), &Dimensions::ChangeNotifier::lineWidthChanged, this, &Circle::setLineWidth);
     connect(m_screenInfo, &ScreenInfo::resolutionChanged, this, [this]() {
         setPosition(m_center, m_perimeter);
-        repaint();
+        schedulePaint();
     });
 }
 
@@ -50,17 +50,19 @@ void Circle::colorChanged(Colors::Item item, QRgb color) {
 
 void Circle::setColor(QRgb color) {
     m_pen.setColor(color);
-    repaint();
+    schedulePaint();
 }
 
 void Circle::setLineWidth(int width) {
     m_pen.setWidth(width);
-    repaint();
+    updateMask();
+    schedulePaint();
 }
 
 void Circle::setGap(double gap) {
     m_gap = gap;
-    repaint();
+    updateMask();
+    schedulePaint();
 }
 
 void Circle::setPosition(const QPoint& center, const QPoint& perimeter) {
@@ -71,10 +73,11 @@ void Circle::setPosition(const QPoint& center, const QPoint& perimeter) {
     const int x = qRound(m_center.x() - m_radius);
     const int y = qRound(m_center.y() - m_radius);
     const int wh = qRound(2.0 * m_radius);
-    setGeometry(QRect(x, y, wh, wh));
+    setGraphicGeometry(QRect(x, y, wh, wh));
+    updateMask();
 }
 
-void Circle::paintEvent(QPaintEvent*) {
+QPainterPath Circle::createArc() const {
     const int screenIndex = m_screenInfo->screenForPoint(m_perimeter);
     const QSizeF screenRes = m_screenInfo->getScreenRes(screenIndex);
 
@@ -90,7 +93,14 @@ void Circle::paintEvent(QPaintEvent*) {
     QPainterPath path;
     path.arcMoveTo(winRect, startAngle);
     path.arcTo(winRect, startAngle, spanAngle);
+    return path;
+}
 
+void Circle::updateMask() {
+    setOutlineMask(createArc(), m_pen.width());
+}
+
+void Circle::paintEvent(QPaintEvent*) {
     QPainter painter(this);
-    painter.strokePath(path, m_pen);
+    painter.strokePath(createArc(), m_pen);
 }
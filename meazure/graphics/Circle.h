@@ -24,6 +24,7 @@
 #include <meazure/units/UnitsProvider.h>
 #include <QPoint>
 #include <QPen>
+#include <QPainterPath>
 
 
 /// A circle graphical element. The circle is positioned by specifying the center and it is sized by specifying a
@@ -80,6 +81,14 @@ private slots:
     void colorChanged(Colors::Item item, QRgb color);
 
 private:
+    /// Creates the arc to draw, in widget coordinates. The arc is open by the gap around the perimeter point.
+    ///
+    /// @return Arc to draw
+    ///
+    [[nodiscard]] QPainterPath createArc() const;
+
+    void updateMask();
+
     double m_gap;
     QPen m_pen;
     QPoint m_center;
@@ -24,6 +24,27 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QGraphicsOpacityEffect>
+#include <QRegion>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+
+/// Shape of the crosshair at a screen resolution, along with the images of the crosshair rendered in that shape.
+///
+struct Crosshair::Shape {
+    using FrameKey = std::tuple<QRgb, QRgb, qreal>;       ///< Fill color, outline color, device pixel ratio
+
+    static constexpr std::size_t k_maxFrames { 16 };     ///< Frames cached before the cache is cleared
+
+    QSize size;                             ///< Size of the crosshair window, in pixels
+    QPoint centerOffset;                    ///< Offset of the crosshair center from its top left corner, in pixels
+    QPainterPath path;                      ///< Outline of the crosshair
+    QRegion mask;                           ///< Window mask derived from the outline
+    std::map<FrameKey, QPixmap> frames;     ///< Rendered crosshair images
+};
 
 
 Crosshair::Crosshair(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider,
@@ -66,14 +87,67 @@ void Crosshair::init() {
     const int screenIndex = m_screenInfo->screenForPoint(screenCenter);
     const QSizeF screenRes = m_screenInfo->getScreenRes(screenIndex);
 
+    const std::shared_ptr<Shape> shape = getShape(screenRes);
+    const bool sameSize = (m_shape != nullptr && m_shape->size == shape->size);
+    m_shape = shape;
+    m_centerOffset = m_shape->centerOffset;
+
+    setFixedSize(m_shape->size);
+    if (sameSize) {
+        // The size is unchanged so there is no resize event to update the mask.
+        setMask(m_shape->mask);
+    }
+}
+
+std::shared_ptr<Crosshair::Shape> Crosshair::getShape(const QSizeF& screenRes) const {
+    static std::map<std::pair<qreal, qreal>, std::weak_ptr<Shape>> shapes;
+
+    const std::pair<qreal, qreal> key(screenRes.width(), screenRes.height());
+    std::shared_ptr<Shape> shape = shapes[key].lock();
+    if (shape != nullptr) {
+        return shape;
+    }
+
+    for (auto iter = shapes.begin(); iter != shapes.end();) {
+        iter = iter->second.expired() ? shapes.erase(iter) : std::next(iter);
+    }
+
     QSize actualSize = m_unitsProvider->convertToPixels(InchesId, screenRes, k_outerSize, k_outerSizeMin);
     actualSize.rwidth() = MathUtils::makeOddUp(actualSize.width());       // Must be odd
     actualSize.rheight() = MathUtils::makeOddUp(actualSize.height());
 
-    m_centerOffset = QPoint((actualSize.width() - 1) / 2, (actualSize.height() - 1) / 2);
-    m_crosshair = generateCrosshair(screenRes, actualSize);
+    shape = std::make_shared<Shape>();
+    shape->size = actualSize;
+    shape->centerOffset = QPoint((actualSize.width() - 1) / 2, (actualSize.height() - 1) / 2);
+    shape->path = generateCrosshair(screenRes, actualSize);
+    shape->mask = QRegion(shape->path.toFillPolygon().toPolygon());
+
+    shapes[key] = shape;
+    return shape;
+}
+
+const QPixmap& Crosshair::getFrame(const QColor& fillColor, const QColor& outlineColor) const {
+    const qreal pixelRatio = devicePixelRatioF();
+    const Shape::FrameKey key(fillColor.rgba(), outlineColor.rgba(), pixelRatio);
+
+    const auto iter = m_shape->frames.find(key);
+    if (iter != m_shape->frames.end()) {
+        return iter->second;
+    }
+
+    if (m_shape->frames.size() >= Shape::k_maxFrames) {
+        m_shape->frames.clear();
+    }
+
+    QPixmap frame(m_shape->size * pixelRatio);
+    frame.setDevicePixelRatio(pixelRatio);
+    frame.fill(fillColor);
 
-    setFixedSize(actualSize);
+    QPainter painter(&frame);
+    painter.strokePath(m_shape->path, QPen(QBrush(outlineColor), k_outlineWidth));
+    painter.end();
+
+    return m_shape->frames.emplace(key, std::move(frame)).first->second;
 }
 
 void Crosshair::colorChanged(Colors::Item item, QRgb color) {
@@ -101,7 +175,7 @@ void Crosshair::setColors(QRgb background, QRgb highlight, QRgb border) {
     m_highlightPen.setColor(highlight);
     m_borderPen.setColor(border);
 
-    repaint();
+    schedulePaint();
 }
 
 void Crosshair::setOpacity(int opacityPercent) {
@@ -115,7 +189,7 @@ void Crosshair::setOpacity(int opacityPercent) {
 
 void Crosshair::setColorMode(ColorMode mode) {
     m_colorMode = mode;
-    repaint();
+    schedulePaint();
 }
 
 void Crosshair::setPosition(const QPoint &center) {
@@ -144,7 +218,7 @@ void Crosshair::flashHandler() {
         m_highlight = !m_highlight;
     }
 
-    repaint();
+    paintNow();
 }
 
 void Crosshair::paintEvent(QPaintEvent*) {
@@ -153,21 +227,19 @@ void Crosshair::paintEvent(QPaintEvent*) {
     const QBrush& fillBrush = (m_colorMode == Auto)
             ? (m_pointerOver ? m_highlightBrush : m_backgroundBrush)
             : ((m_colorMode == AlwaysBackground) ? m_backgroundBrush : m_highlightBrush);
-    painter.fillRect(rect(), fillBrush);
-
     const QPen& outlinePen = m_highlight ? m_highlightPen : m_borderPen;
-    painter.strokePath(m_crosshair, outlinePen);
+
+    painter.drawPixmap(0, 0, getFrame(fillBrush.color(), outlinePen.color()));
 }
 
 void Crosshair::resizeEvent(QResizeEvent*) {
-    const QRegion maskedRegion(m_crosshair.toFillPolygon().toPolygon());
-    setMask(maskedRegion);
+    setMask(m_shape->mask);
 }
 
 void Crosshair::enterEvent(QEnterEvent* event) {
     m_pointerOver = true;
 
-    repaint();
+    schedulePaint();
 
     const QPoint center = findCenter(event->position().toPoint());
     emit entered(*this, m_id, center, event->modifiers());
@@ -176,7 +248,7 @@ void Crosshair::enterEvent(QEnterEvent* event) {
 void Crosshair::leaveEvent(QEvent*) {
     m_pointerOver = false;
 
-    repaint();
+    schedulePaint();
 
     emit departed(*this, m_id);
 }
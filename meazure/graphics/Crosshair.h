@@ -27,7 +27,10 @@
 #include <QPoint>
 #include <QTimer>
 #include <QBrush>
+#include <QPixmap>
+#include <QColor>
 #include <QPen>
+#include <memory>
 
 
 /// A crosshair graphical element. A crosshair consists of four triangular window segments called petals arranged
@@ -35,6 +38,10 @@
 /// of the measurement tools to identify their measurement points and to allow the user to perform measurements
 /// by dragging the crosshairs using the pointer.
 ///
+/// All crosshairs have the same shape at a given screen resolution. The shape, its window mask and the rendered
+/// crosshair images are therefore shared by all crosshairs through a cache keyed by the screen resolution. Painting
+/// a crosshair, including each step of a flash, draws one of the cached images.
+///
 class Crosshair : public Graphic {
 
     Q_OBJECT
@@ -191,8 +198,26 @@ private:
     static constexpr int k_defaultFlashCount { 9 };
     static constexpr int k_strobeCount { 1 };
 
+    struct Shape;
+
     void init();
 
+    /// Obtains the shape of the crosshair at the specified screen resolution. Shapes are shared by all crosshairs
+    /// and are created the first time they are requested. A shape is released when no crosshair uses it.
+    ///
+    /// @param[in] screenRes Screen resolution in pixels / inch
+    /// @return Shape of the crosshair at the specified resolution.
+    ///
+    [[nodiscard]] std::shared_ptr<Shape> getShape(const QSizeF& screenRes) const;
+
+    /// Obtains the image of the crosshair in the specified colors, rendering it if it has not already been cached.
+    ///
+    /// @param[in] fillColor Crosshair background color
+    /// @param[in] outlineColor Crosshair outline color
+    /// @return Image of the crosshair.
+    ///
+    [[nodiscard]] const QPixmap& getFrame(const QColor& fillColor, const QColor& outlineColor) const;
+
     /// Determines the center point of the crosshair relative to the specified point.
     ///
     /// @param point  [in] Current location of the pointer, in pixels, relative to the widget.
@@ -214,7 +239,7 @@ private:
     QBrush m_highlightBrush;
     QPen m_highlightPen;
     QPen m_borderPen;
-    QPainterPath m_crosshair;
+    std::shared_ptr<Shape> m_shape;
     bool m_pointerOver { false };
     bool m_highlight { false };
     QPoint m_centerOffset;
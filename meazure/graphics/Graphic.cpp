@@ -16,9 +16,99 @@
  */
 
 #include "Graphic.h"
+#include "GraphicOverlay.h"
 #include "x11/X11GraphicTag.h"
 #include <meazure/utils/PlatformUtils.h>
+#include <meazure/utils/RefreshPacer.h>
 #include <QEvent>
+#include <QPaintEvent>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QCoreApplication>
+#include <QPainterPathStroker>
+#include <QPolygonF>
+#include <vector>
+#include <algorithm>
+
+
+/// Paints the graphics with scheduled paints at most once per display refresh. Paints requested after a pause are
+/// performed as soon as control returns to the event loop, so that all the changes made while handling an event
+/// are painted together. Paints requested during continuous changes are delayed to the end of the refresh interval.
+///
+class Graphic::Scheduler : public QObject {
+
+public:
+    static Scheduler* instance() {
+        QPointer<Scheduler>& scheduler = pointer();
+        if (scheduler.isNull()) {
+            scheduler = new Scheduler(QCoreApplication::instance());
+        }
+        return scheduler;
+    }
+
+    static void cancelPaint(Graphic* graphic) {
+        Scheduler* scheduler = pointer();
+        if (scheduler != nullptr) {
+            std::vector<Graphic*>& pending = scheduler->m_pending;
+            pending.erase(std::remove(pending.begin(), pending.end(), graphic), pending.end());
+        }
+    }
+
+    static void countPaint() {
+        if (!s_paintPeriod.isValid()) {
+            s_paintPeriod.start();
+        }
+
+        const qint64 elapsed = s_paintPeriod.elapsed();
+        if (elapsed >= k_ratePeriod) {
+            s_paintRate = (s_paintCount * 1000.0) / static_cast<double>(elapsed);
+            s_paintCount = 0;
+            s_paintPeriod.start();
+        }
+
+        s_paintCount++;
+    }
+
+    static double paintRate() {
+        // If nothing has been painted for a while, the last rate is stale.
+        return (s_paintPeriod.isValid() && s_paintPeriod.elapsed() < 2 * k_ratePeriod) ? s_paintRate : 0.0;
+    }
+
+    void schedulePaint(Graphic* graphic) {
+        m_pending.push_back(graphic);
+        m_pacer.schedule();
+    }
+
+private:
+    static constexpr qint64 k_ratePeriod { 1000 };      // Period over which the paint rate is measured, milliseconds
+
+    /// The scheduler is owned by the application so that its timer is destroyed while the application exists.
+    ///
+    static QPointer<Scheduler>& pointer() {
+        static QPointer<Scheduler> scheduler;
+        return scheduler;
+    }
+
+    explicit Scheduler(QObject* parent) : QObject(parent) {
+        connect(&m_pacer, &RefreshPacer::triggered, this, &Scheduler::paint);
+    }
+
+    void paint() {
+        // A graphic may schedule another paint while it is being painted, so paint from a copy of the list.
+        std::vector<Graphic*> pending;
+        pending.swap(m_pending);
+        for (Graphic* graphic : pending) {
+            graphic->paintScheduled();
+        }
+    }
+
+    inline static QElapsedTimer s_paintPeriod;
+    inline static int s_paintCount { 0 };
+    inline static double s_paintRate { 0.0 };
+
+    std::vector<Graphic*> m_pending;
+    RefreshPacer m_pacer;
+};
 
 
 Graphic::Graphic(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, QWidget *parent) :
@@ -32,6 +122,23 @@ Graphic::Graphic(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvide
     }
 }
 
+Graphic::~Graphic() {
+    if (m_paintScheduled) {
+        Scheduler::cancelPaint(this);
+    }
+
+    if (m_overlayShown) {
+        GraphicOverlay* overlay = GraphicOverlay::existingInstance();
+        if (overlay != nullptr) {
+            overlay->removeGraphic(this);
+        }
+    }
+
+    if (PlatformUtils::isX11()) {
+        X11GraphicTag::removeWindow(this);
+    }
+}
+
 bool Graphic::isGraphicWindow(unsigned long windowId) {
     if (PlatformUtils::isX11()) {
         return X11GraphicTag::isGraphicWindow(windowId);
@@ -40,10 +147,128 @@ bool Graphic::isGraphicWindow(unsigned long windowId) {
     return false;
 }
 
+double Graphic::getPaintsPerSecond() {
+    return Scheduler::paintRate();
+}
+
 bool Graphic::event(QEvent* ev) {
     if (PlatformUtils::isX11()) {
         X11GraphicTag::processEvents(this, ev);
     }
 
+    if (ev->type() == QEvent::Paint) {
+        Scheduler::countPaint();
+
+        // Areas painted for any reason (e.g. a resize) need not be painted again by a scheduled paint.
+        m_dirtyRegion -= dynamic_cast<QPaintEvent*>(ev)->region();
+    }
+
     return QWidget::event(ev);
 }
+
+void Graphic::setVisible(bool visible) {
+    if (!isOverlaid()) {
+        QWidget::setVisible(visible);
+        return;
+    }
+
+    // The graphic is drawn in the overlay, so its own window is never shown.
+    if (visible == m_overlayShown) {
+        return;
+    }
+
+    m_overlayShown = visible;
+
+    GraphicOverlay* overlay = GraphicOverlay::instance();
+    if (visible) {
+        overlay->addGraphic(this);
+    } else {
+        overlay->removeGraphic(this);
+    }
+}
+
+bool Graphic::isShown() const {
+    return m_overlayShown || isVisible();
+}
+
+void Graphic::setGraphicGeometry(const QRect& rect) {
+    const QRect oldRect = geometry();
+    setGeometry(rect);
+
+    if (m_overlayShown && rect != oldRect) {
+        GraphicOverlay* overlay = GraphicOverlay::instance();
+        overlay->damage(oldRect);
+        overlay->damage(rect);
+    }
+}
+
+void Graphic::setOutlineMask(const QPainterPath& outline, int lineWidth) {
+    if (lineWidth == m_maskLineWidth && outline == m_maskOutline) {
+        return;
+    }
+    m_maskOutline = outline;
+    m_maskLineWidth = lineWidth;
+
+    QPainterPathStroker stroker;
+    stroker.setWidth(lineWidth + 2 * k_outlineMaskMargin);
+    stroker.setCapStyle(Qt::SquareCap);
+    stroker.setJoinStyle(Qt::MiterJoin);
+
+    // Each open subpath is stroked into a single polygon, which may overlap itself (e.g. where the ends of an
+    // arc meet), so the polygons are filled using the winding rule and combined.
+    QRegion region;
+    for (const QPolygonF& polygon : stroker.createStroke(outline).toFillPolygons()) {
+        region += QRegion(polygon.toPolygon(), Qt::WindingFill);
+    }
+
+    setMask(region);
+}
+
+bool Graphic::isOverlaid() const {
+    return GraphicOverlay::isEnabled() && isWindow() && windowFlags().testFlag(Qt::WindowTransparentForInput);
+}
+
+void Graphic::schedulePaint() {
+    schedulePaint(rect());
+}
+
+void Graphic::schedulePaint(const QRect& area) {
+    m_dirtyRegion += area;
+
+    if (!m_paintScheduled) {
+        m_paintScheduled = true;
+        Scheduler::instance()->schedulePaint(this);
+    }
+}
+
+void Graphic::paintNow() {
+    if (m_paintScheduled) {
+        Scheduler::cancelPaint(this);
+        m_paintScheduled = false;
+    }
+    m_dirtyRegion = QRegion();
+
+    if (m_overlayShown) {
+        GraphicOverlay::instance()->repaintNow(geometry());
+    } else {
+        repaint();
+    }
+}
+
+void Graphic::paintScheduled() {
+    m_paintScheduled = false;
+
+    const QRegion region = m_dirtyRegion;
+    m_dirtyRegion = QRegion();
+
+    if (region.isEmpty()) {
+        return;
+    }
+
+    // Hidden graphics are painted when they are shown.
+    if (m_overlayShown) {
+        GraphicOverlay::instance()->damage(region.translated(pos()));
+    } else if (isVisible()) {
+        repaint(region);
+    }
+}
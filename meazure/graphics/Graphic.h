@@ -18,6 +18,9 @@
 #pragma once
 
 #include <QWidget>
+#include <QRegion>
+#include <QRect>
+#include <QPainterPath>
 #include <meazure/environment/ScreenInfo.h>
 #include <meazure/units/UnitsProvider.h>
 
@@ -25,18 +28,100 @@
 /// Base class for all graphic elements. Classes derived from this base class are used by the measurement tools
 /// to perform their function.
 ///
+/// Graphics do not paint themselves each time their state changes. Instead, the changed areas are accumulated and
+/// each graphic is painted at most once per display refresh. All graphics with pending paints are painted together
+/// so that, for example, a point, its ruler indicator and its data window moved by one drag step are painted in the
+/// same frame. Effects that depend on precise timing (e.g. flashing) can paint immediately.
+///
+/// When the GraphicOverlay is enabled, top level graphics that do not accept input do not have windows of their
+/// own. Showing such a graphic adds it to the overlay, which draws it, and painting it repaints the corresponding
+/// area of the overlay. Derived classes must position themselves using setGraphicGeometry so that the overlay is
+/// repainted when they move.
+///
 class Graphic : public QWidget {
 
     Q_OBJECT
 
 public:
     explicit Graphic(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, QWidget* parent);
+    ~Graphic() override;
+
+    Graphic(const Graphic&) = delete;
+    Graphic(Graphic&&) = delete;
+    Graphic& operator=(const Graphic&) = delete;
 
     static bool isGraphicWindow(unsigned long windowId);
 
+    /// Obtains the number of times graphics were painted during the most recent one second period. Use this to
+    /// gauge the painting load imposed by the graphics.
+    ///
+    /// @return Number of graphic paints per second.
+    ///
+    static double getPaintsPerSecond();
+
     bool event(QEvent* ev) override;
 
+    void setVisible(bool visible) override;
+
+    /// Indicates whether the graphic is shown. A graphic drawn in the overlay is shown while it is in the overlay,
+    /// even though its own window is never visible.
+    ///
+    /// @return true if the graphic is shown in its own window or in the overlay.
+    ///
+    [[nodiscard]] bool isShown() const;
+
 protected:
+    /// Sets the position and size of the graphic. Use this method rather than setGeometry, so that the area
+    /// previously occupied by a graphic drawn in the overlay is repainted.
+    ///
+    /// @param[in] rect Position and size of the graphic, in global coordinates for a top level graphic
+    ///
+    void setGraphicGeometry(const QRect& rect);
+
+    /// Shapes the graphic so that it only covers the area around the specified outline, rather than its entire
+    /// bounding box. Only the outline area of the window is composited, painted and sensitive to the pointer. The
+    /// mask is only recalculated if the outline or line width differ from those of the current mask (e.g. a graphic
+    /// that is moved without changing its shape keeps its mask).
+    ///
+    /// @param[in] outline Outline to be drawn by the graphic, in widget coordinates. The outline must consist of
+    ///     open subpaths (e.g. lines and arcs).
+    /// @param[in] lineWidth Width of the line used to draw the outline, in pixels
+    ///
+    void setOutlineMask(const QPainterPath& outline, int lineWidth);
+
+    /// Requests that the entire graphic be painted at the next display refresh.
+    ///
+    void schedulePaint();
+
+    /// Requests that the specified area of the graphic be painted at the next display refresh. Areas requested
+    /// before the paint are combined.
+    ///
+    /// @param[in] area Area to paint, in widget coordinates
+    ///
+    void schedulePaint(const QRect& area);
+
+    /// Paints the entire graphic immediately, including any area with a scheduled paint. Use this for effects that
+    /// must be seen at a precise time, such as flashing.
+    ///
+    void paintNow();
+
     const ScreenInfo* m_screenInfo;
     const UnitsProvider* m_unitsProvider;
+
+private:
+    static constexpr int k_outlineMaskMargin { 1 };     // Added around outlines so they are not clipped, pixels
+
+    class Scheduler;
+
+    void paintScheduled();
+
+    /// Indicates whether the graphic is drawn in the overlay rather than in its own window.
+    ///
+    [[nodiscard]] bool isOverlaid() const;
+
+    QRegion m_dirtyRegion;              ///< Area to paint at the next display refresh
+    QPainterPath m_maskOutline;         ///< Outline used to create the current window mask
+    int m_maskLineWidth { -1 };         ///< Line width used to create the current window mask
+    bool m_paintScheduled { false };
+    bool m_overlayShown { false };      ///< Graphic is shown in the overlay
 };
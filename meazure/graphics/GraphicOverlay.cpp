@@ -0,0 +1,224 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "GraphicOverlay.h"
+#include "Graphic.h"
+#include "x11/X11GraphicTag.h"
+#include <meazure/utils/PlatformUtils.h>
+#include <QWidget>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QApplication>
+#include <QScreen>
+#include <algorithm>
+
+
+/// Translucent, input transparent window covering a screen, into which the overlay graphics are drawn.
+///
+class GraphicOverlay::Surface : public QWidget {
+
+public:
+    Surface(const GraphicOverlay* overlay, const QRect& screenRect) :
+            QWidget(nullptr, Qt::Window | Qt::FramelessWindowHint | Qt::X11BypassWindowManagerHint |
+                             Qt::WindowTransparentForInput),
+            m_overlay(overlay) {
+        setAttribute(Qt::WA_NoSystemBackground);
+        setAttribute(Qt::WA_TranslucentBackground);
+        setAttribute(Qt::WA_ShowWithoutActivating);
+        setAttribute(Qt::WA_QuitOnClose, false);
+        setGeometry(screenRect);
+    }
+
+    ~Surface() override {
+        if (PlatformUtils::isX11()) {
+            X11GraphicTag::removeWindow(this);
+        }
+    }
+
+    Surface(const Surface&) = delete;
+    Surface(Surface&&) = delete;
+    Surface& operator=(const Surface&) = delete;
+
+protected:
+    bool event(QEvent* ev) override {
+        // The overlay windows are recognized as graphic windows so that, for example, the Window tool ignores them.
+        if (PlatformUtils::isX11()) {
+            X11GraphicTag::processEvents(this, ev);
+        }
+
+        return QWidget::event(ev);
+    }
+
+    void paintEvent(QPaintEvent* ev) override {
+        // The damaged area has already been cleared because the window has a translucent background.
+        QPainter painter(this);
+
+        for (Graphic* graphic : m_overlay->m_graphics) {
+            const QRect area = graphic->geometry().translated(-pos());
+            const QRegion region = ev->region().intersected(area);
+            if (!region.isEmpty()) {
+                graphic->render(&painter, area.topLeft(), region.translated(-area.topLeft()), RenderFlags());
+            }
+        }
+    }
+
+private:
+    const GraphicOverlay* m_overlay;
+};
+
+
+void GraphicOverlay::setEnabled(bool enable) {
+    s_enabled = enable;
+}
+
+bool GraphicOverlay::isEnabled() {
+    return s_enabled;
+}
+
+GraphicOverlay* GraphicOverlay::instance() {
+    QPointer<GraphicOverlay>& overlay = pointer();
+    if (overlay.isNull()) {
+        overlay = new GraphicOverlay(QCoreApplication::instance());
+    }
+    return overlay;
+}
+
+GraphicOverlay* GraphicOverlay::existingInstance() {
+    return pointer();
+}
+
+QPointer<GraphicOverlay>& GraphicOverlay::pointer() {
+    static QPointer<GraphicOverlay> overlay;
+    return overlay;
+}
+
+GraphicOverlay::GraphicOverlay(QObject* parent) : QObject(parent) {
+    createSurfaces();
+
+    // The screen changes are handled once Qt has finished updating its list of screens.
+    const auto* app = qobject_cast<QGuiApplication*>(QCoreApplication::instance());
+    connect(app, &QGuiApplication::screenAdded, this, &GraphicOverlay::screensChanged, Qt::QueuedConnection);
+    connect(app, &QGuiApplication::screenRemoved, this, &GraphicOverlay::screensChanged, Qt::QueuedConnection);
+
+    // The overlay windows must be destroyed while the application is still running.
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &GraphicOverlay::close);
+}
+
+GraphicOverlay::~GraphicOverlay() {
+    deleteSurfaces();
+}
+
+void GraphicOverlay::addGraphic(Graphic* graphic) {
+    if (std::find(m_graphics.begin(), m_graphics.end(), graphic) != m_graphics.end()) {
+        return;
+    }
+
+    m_graphics.push_back(graphic);
+    damage(graphic->geometry());
+
+    if (m_graphics.size() == 1) {
+        showSurfaces();
+    }
+}
+
+void GraphicOverlay::removeGraphic(Graphic* graphic) {
+    const auto iter = std::find(m_graphics.begin(), m_graphics.end(), graphic);
+    if (iter == m_graphics.end()) {
+        return;
+    }
+
+    m_graphics.erase(iter);
+    damage(graphic->geometry());
+
+    if (m_graphics.empty()) {
+        hideSurfaces();
+    }
+}
+
+void GraphicOverlay::damage(const QRegion& area) {
+    for (Surface* surface : m_surfaces) {
+        const QRegion surfaceArea = area.intersected(surface->geometry());
+        if (!surfaceArea.isEmpty()) {
+            surface->update(surfaceArea.translated(-surface->pos()));
+        }
+    }
+}
+
+void GraphicOverlay::repaintNow(const QRect& area) {
+    for (Surface* surface : m_surfaces) {
+        const QRect surfaceArea = area.intersected(surface->geometry());
+        if (!surfaceArea.isEmpty()) {
+            surface->repaint(surfaceArea.translated(-surface->pos()));
+        }
+    }
+}
+
+void GraphicOverlay::createSurfaces() {
+    for (QScreen* screen : QGuiApplication::screens()) {
+        m_surfaces.push_back(new Surface(this, screen->geometry()));
+
+        connect(screen, &QScreen::geometryChanged, this, &GraphicOverlay::screensChanged,
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection));
+    }
+}
+
+void GraphicOverlay::screensChanged() {
+    if (m_closed) {
+        return;
+    }
+
+    deleteSurfaces();
+    createSurfaces();
+
+    // The new surfaces paint all the graphics in the overlay when they are first exposed.
+    if (!m_graphics.empty()) {
+        showSurfaces();
+    }
+}
+
+void GraphicOverlay::showSurfaces() {
+    for (Surface* surface : m_surfaces) {
+        surface->show();
+    }
+
+    // Newly shown windows are stacked on top. Graphics that have their own windows (e.g. crosshairs) must remain
+    // above the overlay.
+    for (QWidget* widget : QApplication::topLevelWidgets()) {
+        auto* graphic = qobject_cast<Graphic*>(widget);
+        if (graphic != nullptr && graphic->isVisible()) {
+            graphic->raise();
+        }
+    }
+}
+
+void GraphicOverlay::hideSurfaces() {
+    for (Surface* surface : m_surfaces) {
+        surface->hide();
+    }
+}
+
+void GraphicOverlay::close() {
+    m_closed = true;
+    deleteSurfaces();
+}
+
+void GraphicOverlay::deleteSurfaces() {
+    for (Surface* surface : m_surfaces) {
+        delete surface;
+    }
+    m_surfaces.clear();
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QRect>
+#include <QRegion>
+#include <QPointer>
+#include <vector>
+
+
+class Graphic;
+
+
+/// Draws the top level graphics that do not accept input (e.g. lines, rectangles, rulers) into a single translucent,
+/// input transparent window per screen, instead of each graphic having a window of its own. Moving such a graphic
+/// then only repaints the damaged areas of the overlay windows, rather than reconfiguring a window, and the
+/// compositor has one layer per screen rather than one per graphic.
+///
+/// The overlay is optional and must be enabled before any graphic is created. Graphics that accept input
+/// (e.g. crosshairs) always have their own windows, which are kept above the overlay windows. The overlay windows
+/// are recreated whenever a screen is added, removed or changes geometry, so that they always cover the screens.
+///
+class GraphicOverlay : public QObject {
+
+    Q_OBJECT
+
+public:
+    ~GraphicOverlay() override;
+
+    GraphicOverlay(const GraphicOverlay&) = delete;
+    GraphicOverlay(GraphicOverlay&&) = delete;
+    GraphicOverlay& operator=(const GraphicOverlay&) = delete;
+
+    /// Enables or disables drawing graphics into the overlay. Call this method before any graphic is created.
+    ///
+    /// @param[in] enable true to draw input transparent top level graphics into the overlay
+    ///
+    static void setEnabled(bool enable);
+
+    /// Indicates whether graphics are drawn into the overlay.
+    ///
+    /// @return true if input transparent top level graphics are drawn into the overlay.
+    ///
+    static bool isEnabled();
+
+    /// Obtains the overlay, creating it if necessary. The overlay is owned by the application.
+    ///
+    /// @return Overlay shared by all graphics.
+    ///
+    static GraphicOverlay* instance();
+
+    /// Obtains the overlay, if it has been created.
+    ///
+    /// @return Overlay shared by all graphics, or nullptr if it has not been created.
+    ///
+    static GraphicOverlay* existingInstance();
+
+    /// Adds a graphic to the overlay. The graphic is drawn above the graphics already in the overlay.
+    ///
+    /// @param[in] graphic Graphic to draw in the overlay
+    ///
+    void addGraphic(Graphic* graphic);
+
+    /// Removes a graphic from the overlay.
+    ///
+    /// @param[in] graphic Graphic to remove from the overlay
+    ///
+    void removeGraphic(Graphic* graphic);
+
+    /// Requests that an area of the overlay be repainted when control returns to the event loop. Areas requested
+    /// before the repaint are combined.
+    ///
+    /// @param[in] area Area to repaint, in global coordinates
+    ///
+    void damage(const QRegion& area);
+
+    /// Repaints an area of the overlay immediately.
+    ///
+    /// @param[in] area Area to repaint, in global coordinates
+    ///
+    void repaintNow(const QRect& area);
+
+private:
+    class Surface;
+
+    /// The overlay is owned by the application so that it is destroyed while the application exists.
+    ///
+    static QPointer<GraphicOverlay>& pointer();
+
+    explicit GraphicOverlay(QObject* parent);
+
+    void createSurfaces();
+    void screensChanged();
+    void showSurfaces();
+    void hideSurfaces();
+    void close();
+    void deleteSurfaces();
+
+    inline static bool s_enabled { false };
+
+    std::vector<Surface*> m_surfaces;       ///< Overlay window for each screen
+    std::vector<Graphic*> m_graphics;       ///< Graphics in the overlay, bottommost first
+    bool m_closed { false };                ///< Application is quitting, so surfaces are no longer created
+};
@@ -21,7 +21,9 @@
 #include <QTransform>
 #include <QPainter>
 #include <QLine>
+#include <QBrush>
 #include <vector>
+#include <algorithm>
 
 Grid::Grid(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider,
            QWidget* parent, QRgb lineColor, int lineWidth) :
@@ -35,7 +37,8 @@ Grid::Grid(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider,
     connect(Colors::getChangeNotifier(), &Colors::ChangeNotifier::colorChanged, this, &Grid::colorChanged);
     connect(Dimensions::getChangeNotifier(), &Dimensions::ChangeNotifier::lineWidthChanged, this, &Grid::setLineWidth);
     connect(m_screenInfo, &ScreenInfo::resolutionChanged, this, [this]() {
-        repaint();
+        m_partsValid = false;
+        schedulePaint();
     });
 }
 
@@ -47,12 +50,12 @@ void Grid::colorChanged(Colors::Item item, QRgb color) {
 
 void Grid::setColor(QRgb color) {
     m_pen.setColor(color);
-    repaint();
+    schedulePaint();
 }
 
 void Grid::setLineWidth(int width) {
     m_pen.setWidth(width);
-    repaint();
+    schedulePaint();
 }
 
 void Grid::setPosition(int x, int y, int width, int height, int angle) {
@@ -64,7 +67,7 @@ void Grid::setPosition(int x, int y, int width, int height, int angle) {
     const QTransform boundingTransform = Geometry::rotateAround(m_angle, requestedCenter);
     const QRect boundingRect = boundingTransform.mapRect(requestedDimensions);
 
-    setGeometry(boundingRect);
+    setGraphicGeometry(boundingRect);
 
     m_gridRect.setRect((boundingRect.width() - requestedDimensions.width()) / 2,
                        (boundingRect.height() - requestedDimensions.height()) / 2,
@@ -72,27 +75,33 @@ void Grid::setPosition(int x, int y, int width, int height, int angle) {
                        requestedDimensions.height());
 
     m_gridTransform = Geometry::rotateAround(m_angle, m_gridRect.center());
-
+    m_partsValid = false;
 }
 
 void Grid::setSpacing(double hSpacing, double vSpacing) {
     m_hSpacing = hSpacing;
     m_vSpacing = vSpacing;
-    repaint();
+    m_partsValid = false;
+    schedulePaint();
 }
 
 void Grid::setUnits(LinearUnitsId units) {
     m_units = units;
-    repaint();
+    m_partsValid = false;
+    schedulePaint();
 }
 
-void Grid::paintEvent(QPaintEvent*) {
-    QPainter painter(this);
-    painter.setPen(m_pen);
+void Grid::createParts() {
+    m_parts.clear();
+
+    const bool rotated = (Geometry::normalizeDegrees(m_angle) != 0);
 
     for (int idx = 0; idx < m_screenInfo->getNumScreens(); idx++) {
         const QRect intersectRect = m_screenInfo->getScreenRect(idx).intersected(geometry());
         if (!intersectRect.isEmpty()) {
+            Part& part = m_parts.emplace_back();
+            part.clipRect = QRect(intersectRect.topLeft() - geometry().topLeft(), intersectRect.size());
+
             int hPixelSpacing;      // NOLINT(cppcoreguidelines-init-variables)
             int vPixelSpacing;      // NOLINT(cppcoreguidelines-init-variables)
             if (m_units == PixelsId) {
@@ -108,26 +117,87 @@ void Grid::paintEvent(QPaintEvent*) {
                 vPixelSpacing = qRound(m_vSpacing * unitsRes.height());
             }
 
-            if (hPixelSpacing < k_minSpacing) {
-                hPixelSpacing = k_minSpacing;
-            }
-            if (vPixelSpacing < k_minSpacing) {
-                vPixelSpacing = k_minSpacing;
-            }
+            part.hPixelSpacing = std::max(hPixelSpacing, k_minSpacing);
+            part.vPixelSpacing = std::max(vPixelSpacing, k_minSpacing);
 
-            std::vector<QLine> lines;
-            for (int x = m_gridRect.left(); x <= m_gridRect.right(); x += hPixelSpacing) {
-                lines.emplace_back(x, m_gridRect.bottom(), x, m_gridRect.top());
-            }
-            for (int y = m_gridRect.top(); y <= m_gridRect.bottom(); y += vPixelSpacing) {
-                lines.emplace_back(m_gridRect.left(), y, m_gridRect.right(), y);
+            if (rotated) {
+                for (int x = m_gridRect.left(); x <= m_gridRect.right(); x += part.hPixelSpacing) {
+                    part.lines.emplace_back(x, m_gridRect.bottom(), x, m_gridRect.top());
+                }
+                for (int y = m_gridRect.top(); y <= m_gridRect.bottom(); y += part.vPixelSpacing) {
+                    part.lines.emplace_back(m_gridRect.left(), y, m_gridRect.right(), y);
+                }
             }
+        }
+    }
+
+    m_partsValid = true;
+}
+
+void Grid::createTiles(Part& part) const {
+    // A line drawn by the pen at x covers the pixels from x - width / 2 for the width of the pen. Each tile holds
+    // the pixels covered by one line, positioned at the start of the tile. Bitmap brushes are drawn in the brush
+    // color, so the tiles do not depend on the line color.
+    const int lineWidth = std::max(m_pen.width(), 1);
+
+    part.columnTile = QBitmap(part.hPixelSpacing, k_tileLength);
+    part.columnTile.fill(Qt::color0);
+    QPainter columnPainter(&part.columnTile);
+    columnPainter.fillRect(0, 0, std::min(lineWidth, part.hPixelSpacing), k_tileLength, Qt::color1);
+
+    part.rowTile = QBitmap(k_tileLength, part.vPixelSpacing);
+    part.rowTile.fill(Qt::color0);
+    QPainter rowPainter(&part.rowTile);
+    rowPainter.fillRect(0, 0, k_tileLength, std::min(lineWidth, part.vPixelSpacing), Qt::color1);
 
-            const QRect clipRect(intersectRect.topLeft() - geometry().topLeft(), intersectRect.size());
+    part.tileLineWidth = m_pen.width();
+}
+
+void Grid::paintPattern(QPainter& painter, const Part& part) const {
+    const int lineWidth = std::max(m_pen.width(), 1);
+    const int before = lineWidth / 2;               // Pixels covered before the line position
+    const int after = lineWidth - 1 - before;       // Pixels covered after the line position
+
+    const int lastX = m_gridRect.left() + ((m_gridRect.right() - m_gridRect.left()) / part.hPixelSpacing)
+                                          * part.hPixelSpacing;
+    const int lastY = m_gridRect.top() + ((m_gridRect.bottom() - m_gridRect.top()) / part.vPixelSpacing)
+                                         * part.vPixelSpacing;
+    const QPoint origin(m_gridRect.left() - before, m_gridRect.top() - before);
+
+    painter.save();
+    painter.setClipRect(part.clipRect);
+    painter.setBrushOrigin(origin);
+
+    // Vertical lines span the height of the grid, up to the last vertical line.
+    painter.fillRect(QRect(origin, QPoint(lastX + after, m_gridRect.bottom() + after)),
+                     QBrush(m_pen.color(), part.columnTile));
+
+    // Horizontal lines span the width of the grid, up to the last horizontal line.
+    painter.fillRect(QRect(origin, QPoint(m_gridRect.right() + after, lastY + after)),
+                     QBrush(m_pen.color(), part.rowTile));
+
+    painter.restore();
+}
+
+void Grid::paintEvent(QPaintEvent*) {
+    if (!m_partsValid) {
+        createParts();
+    }
+
+    QPainter painter(this);
+    painter.setPen(m_pen);
+
+    for (Part& part : m_parts) {
+        if (part.lines.empty()) {
+            if (part.tileLineWidth != m_pen.width() || part.columnTile.isNull()) {
+                createTiles(part);
+            }
+            paintPattern(painter, part);
+        } else {
             painter.save();
-            painter.setClipRect(clipRect);
+            painter.setClipRect(part.clipRect);
             painter.setTransform(m_gridTransform);
-            painter.drawLines(lines.data(), static_cast<int>(lines.size()));
+            painter.drawLines(part.lines.data(), static_cast<int>(part.lines.size()));
             painter.restore();
         }
     }
@@ -28,11 +28,18 @@
 #include <QRectF>
 #include <QSizeF>
 #include <QTransform>
+#include <QLine>
+#include <QBitmap>
+#include <vector>
 
 
 /// A grid graphical element. Draws a rectangular grid with configurable size, grid spacing and rotation. The grid
 /// spacing can be specified in any of the supported measurement units.
 ///
+/// The grid lines on each screen are calculated when the grid position, spacing, units or screen resolution change,
+/// rather than on each paint. An unrotated grid is filled using pattern brushes whose tiles each contain a single
+/// grid line, which avoids drawing each line individually. A rotated grid is drawn from the calculated lines.
+///
 class Grid : public Graphic {
 
     Q_OBJECT
@@ -101,6 +108,24 @@ private slots:
     void colorChanged(Colors::Item item, QRgb color);
 
 private:
+    static constexpr int k_tileLength { 64 };      // Length of the pattern tiles along the grid lines, pixels
+
+    /// Portion of the grid on a screen.
+    ///
+    struct Part {
+        QRect clipRect;                     ///< Portion of the grid on the screen, in widget coordinates
+        int hPixelSpacing { k_minSpacing }; ///< Horizontal line spacing on the screen, in pixels
+        int vPixelSpacing { k_minSpacing }; ///< Vertical line spacing on the screen, in pixels
+        std::vector<QLine> lines;           ///< Grid lines, if the grid is rotated
+        QBitmap columnTile;                 ///< Tile containing a vertical line, if the grid is not rotated
+        QBitmap rowTile;                    ///< Tile containing a horizontal line, if the grid is not rotated
+        int tileLineWidth { 0 };            ///< Line width with which the tiles were created
+    };
+
+    void createParts();
+    void createTiles(Part& part) const;
+    void paintPattern(QPainter& painter, const Part& part) const;
+
     QPen m_pen;
     QRect m_gridRect;                       ///< Grid rectangle positioned for rotation, in pixels
     QTransform m_gridTransform;             ///< Rotational transform for the grid
@@ -108,4 +133,6 @@ private:
     double m_hSpacing { 50 };               ///< Horizontal line spacing, in m_units
     double m_vSpacing { 50 };               ///< Vertical line spacing, in m_units
     LinearUnitsId m_units { PixelsId };     ///< Units for the grid spacing
+    std::vector<Part> m_parts;              ///< Grid lines on each screen
+    bool m_partsValid { false };
 };
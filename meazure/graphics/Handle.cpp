@@ -91,7 +91,7 @@ void Handle::setColors(QRgb background, QRgb highlight, QRgb border) {
     m_highlightPen.setColor(highlight);
     m_borderPen.setColor(border);
 
-    repaint();
+    schedulePaint();
 }
 
 void Handle::setOpacity(int opacityPercent) {
@@ -124,7 +124,7 @@ void Handle::flashHandler() {
         m_highlight = !m_highlight;
     }
 
-    repaint();
+    paintNow();
 }
 
 void Handle::paintEvent(QPaintEvent*) {
@@ -137,7 +137,7 @@ void Handle::paintEvent(QPaintEvent*) {
 void Handle::enterEvent(QEnterEvent* event) {
     m_pointerOver = true;
 
-    repaint();
+    schedulePaint();
 
     const QPoint center = findCenter(event->position().toPoint());
     emit entered(*this, m_id, center, event->modifiers());
@@ -146,7 +146,7 @@ void Handle::enterEvent(QEnterEvent* event) {
 void Handle::leaveEvent(QEvent*) {
     m_pointerOver = false;
 
-    repaint();
+    schedulePaint();
 
     emit departed(*this, m_id);
 }
@@ -19,6 +19,7 @@
 #include <meazure/utils/Geometry.h>
 #include <QSize>
 #include <QPainter>
+#include <QPainterPath>
 #include <cmath>
 
 
@@ -38,7 +39,7 @@ Line::Line(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, dou
     connect(Dimensions::getChangeNotifier(), &Dimensions::ChangeNotifier::lineWidthChanged, this, &Line::setLineWidth);
     connect(m_screenInfo, &ScreenInfo::resolutionChanged, this, [this]() {
         setPosition(m_start, m_end);
-        repaint();
+        schedulePaint();
     });
 }
 
@@ -50,7 +51,7 @@ void Line::colorChanged(Colors::Item item, QRgb color) {
 
 void Line::setColor(QRgb color) {
     m_pen.setColor(color);
-    repaint();
+    schedulePaint();
 }
 
 void Line::setLineWidth(int width) {
@@ -91,21 +92,28 @@ void Line::setPosition(const QPoint& start, const QPoint& end) {
     //
     windowRect.adjust(-m_lineWidth, -m_lineWidth, m_lineWidth, m_lineWidth);
 
-    setGeometry(windowRect);
-}
+    setGraphicGeometry(windowRect);
 
-void Line::paintEvent(QPaintEvent*) {
-    QPainter painter(this);
-    painter.setPen(m_pen);
+    const QLine line = getLine();
+    QPainterPath outline(line.p1());
+    outline.lineTo(line.p2());
+    setOutlineMask(outline, m_lineWidth);
+}
 
+QLine Line::getLine() const {
     // Compensate for margin.
     //
     const int right = width() - m_lineWidth - 1;
     const int bottom = height() - m_lineWidth - 1;
 
     if ((m_start.x() > m_end.x()) != (m_start.y() > m_end.y())) {
-        painter.drawLine(m_lineWidth, bottom, right, m_lineWidth);
-    } else {
-        painter.drawLine(m_lineWidth, m_lineWidth, right, bottom);
+        return { m_lineWidth, bottom, right, m_lineWidth };
     }
+    return { m_lineWidth, m_lineWidth, right, bottom };
+}
+
+void Line::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    painter.setPen(m_pen);
+    painter.drawLine(getLine());
 }
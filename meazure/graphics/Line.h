@@ -24,6 +24,7 @@
 #include <meazure/units/UnitsProvider.h>
 #include <QPoint>
 #include <QPen>
+#include <QLine>
 
 
 /// A line graphical element. The line is used by many tools including the Line and Grid tools. The line is positioned
@@ -83,6 +84,12 @@ private slots:
     void colorChanged(Colors::Item item, QRgb color);
 
 private:
+    /// Obtains the line to draw, in widget coordinates.
+    ///
+    /// @return Line to draw
+    ///
+    [[nodiscard]] QLine getLine() const;
+
     double m_offset;
     int m_lineWidth;
     QPen m_pen;
@@ -19,6 +19,7 @@
 #include <QPainter>
 #include <QSizeF>
 #include <QBrush>
+#include <QRect>
 
 
 OriginMarker::OriginMarker(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider,
@@ -34,7 +35,7 @@ OriginMarker::OriginMarker(const ScreenInfo* screenInfo, const UnitsProvider* un
             &OriginMarker::setLineWidth);
     connect(m_screenInfo, &ScreenInfo::resolutionChanged, this, [this]() {
         setPosition(m_origin, m_inverted);
-        repaint();
+        schedulePaint();
     });
 }
 
@@ -46,12 +47,12 @@ void OriginMarker::colorChanged(Colors::Item item, QRgb color) {
 
 void OriginMarker::setColor(QRgb color) {
     m_pen.setColor(color);
-    repaint();
+    schedulePaint();
 }
 
 void OriginMarker::setLineWidth(int width) {
     m_pen.setWidth(width);
-    repaint();
+    schedulePaint();
 }
 
 void OriginMarker::setPosition(const QPoint& origin, bool inverted) {
@@ -66,9 +67,10 @@ void OriginMarker::setPosition(const QPoint& origin, bool inverted) {
     m_axisLength = m_unitsProvider->convertToPixels(InchesId, res, k_axesLength, k_axesLengthMin);
 
     if (inverted) {
-        setGeometry(m_origin.x(), m_origin.y() - m_axisLength.height(), m_axisLength.width(), m_axisLength.height());
+        setGraphicGeometry(QRect(m_origin.x(), m_origin.y() - m_axisLength.height(), m_axisLength.width(),
+                                 m_axisLength.height()));
     } else {
-        setGeometry(m_origin.x(), m_origin.y(), m_axisLength.width(), m_axisLength.height());
+        setGraphicGeometry(QRect(m_origin.x(), m_origin.y(), m_axisLength.width(), m_axisLength.height()));
     }
 }
 
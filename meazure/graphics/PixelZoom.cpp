@@ -0,0 +1,265 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PixelZoom.h"
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSE2__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MEA_PIXEL_ZOOM_AVX2
+#include <immintrin.h>
+#endif
+
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+namespace {
+
+    constexpr QRgb k_background { qRgb(0, 0, 0) };
+
+    /// Replicates each source pixel factor times.
+    ///
+    /// @param[in] src Source pixels
+    /// @param[in] count Number of source pixels
+    /// @param[in] factor Number of times to replicate each pixel
+    /// @param[out] dst Receives count * factor pixels
+    ///
+    using ExpandFunc = void (*)(const QRgb* src, int count, int factor, QRgb* dst);
+
+    void expandScalar(const QRgb* src, int count, int factor, QRgb* dst) {
+        if (factor == 1) {
+            std::memcpy(dst, src, static_cast<std::size_t>(count) * sizeof(QRgb));
+            return;
+        }
+
+        for (int i = 0; i < count; i++) {
+            std::fill_n(dst, factor, src[i]);
+            dst += factor;
+        }
+    }
+
+#if defined(__SSE2__)
+
+    void expandSse2(const QRgb* src, int count, int factor, QRgb* dst) {
+        if (factor == 2) {
+            int i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_unpacklo_epi32(pixels, pixels));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 4), _mm_unpackhi_epi32(pixels, pixels));
+            }
+            expandScalar(src + i, count - i, factor, dst + 2 * i);
+            return;
+        }
+
+        if (factor < 4 || count == 0) {
+            expandScalar(src, count, factor, dst);
+            return;
+        }
+
+        // Each pixel is written using whole vector stores. When the factor is not a multiple of four, the last
+        // store spills into the start of the next pixel's run, which is then overwritten by that pixel. The last
+        // pixel is written exactly so that nothing beyond the end of the run is touched.
+        const int stores = (factor + 3) / 4;
+        for (int i = 0; i < count - 1; i++) {
+            const __m128i pixel = _mm_set1_epi32(static_cast<int>(src[i]));
+            QRgb* run = dst + static_cast<std::ptrdiff_t>(i) * factor;
+            for (int s = 0; s < stores; s++) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(run + 4 * s), pixel);
+            }
+        }
+        std::fill_n(dst + static_cast<std::ptrdiff_t>(count - 1) * factor, factor, src[count - 1]);
+    }
+
+#endif
+
+#if defined(MEA_PIXEL_ZOOM_AVX2)
+
+    __attribute__((target("avx2")))
+    void expandAvx2(const QRgb* src, int count, int factor, QRgb* dst) {
+        if (factor < 8 || count == 0) {
+            expandSse2(src, count, factor, dst);
+            return;
+        }
+
+        // See expandSse2 for a description of the overlapping stores.
+        const int stores = (factor + 7) / 8;
+        for (int i = 0; i < count - 1; i++) {
+            const __m256i pixel = _mm256_set1_epi32(static_cast<int>(src[i]));
+            QRgb* run = dst + static_cast<std::ptrdiff_t>(i) * factor;
+            for (int s = 0; s < stores; s++) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(run + 8 * s), pixel);
+            }
+        }
+        std::fill_n(dst + static_cast<std::ptrdiff_t>(count - 1) * factor, factor, src[count - 1]);
+    }
+
+#endif
+
+    ExpandFunc selectExpand() {
+#if defined(MEA_PIXEL_ZOOM_AVX2)
+        if (__builtin_cpu_supports("avx2")) {
+            return expandAvx2;
+        }
+#endif
+#if defined(__SSE2__)
+        return expandSse2;
+#else
+        return expandScalar;
+#endif
+    }
+
+    /// Divides rounding toward negative infinity so that positions to the left of or above the origin map to
+    /// negative source coordinates.
+    ///
+    int floorDiv(int numerator, int denominator) {
+        const int quotient = numerator / denominator;
+        return (numerator % denominator != 0 && numerator < 0) ? quotient - 1 : quotient;
+    }
+
+    void fillSpan(QRgb* row, int width, int start, int end, QRgb color) {
+        start = std::max(start, 0);
+        end = std::min(end, width - 1);
+        if (start <= end) {
+            std::fill(row + start, row + end + 1, color);
+        }
+    }
+
+    void setPixel(QRgb* row, int width, int x, QRgb color) {
+        if (x >= 0 && x < width) {
+            row[x] = color;
+        }
+    }
+
+    void drawOverlay(QRgb* row, int width, int y, const PixelZoom::Overlay& overlay) {
+        for (int i = 0; i < overlay.lineCount; i++) {
+            const QLine& line = overlay.lines[i];
+            if (line.y1() == line.y2()) {
+                if (y == line.y1()) {
+                    fillSpan(row, width, std::min(line.x1(), line.x2()), std::max(line.x1(), line.x2()),
+                             overlay.lineColor);
+                }
+            } else if (line.x1() == line.x2()) {
+                if (y >= std::min(line.y1(), line.y2()) && y <= std::max(line.y1(), line.y2())) {
+                    setPixel(row, width, line.x1(), overlay.lineColor);
+                }
+            }
+        }
+
+        if (!overlay.marker.isNull()) {
+            const int left = overlay.marker.x();
+            const int top = overlay.marker.y();
+            const int right = left + overlay.marker.width();
+            const int bottom = top + overlay.marker.height();
+
+            if (y == top || y == bottom) {
+                fillSpan(row, width, left, right, overlay.markerColor);
+            } else if (y > top && y < bottom) {
+                setPixel(row, width, left, overlay.markerColor);
+                setPixel(row, width, right, overlay.markerColor);
+            }
+        }
+    }
+
+    /// Writes one row of the enlarged source, clipped to the target width.
+    ///
+    void expandRow(ExpandFunc expand, const QRgb* src, int srcCount, int factor, int originX, QRgb* row,
+                   int width) {
+        int col = std::max(0, floorDiv(-originX, factor));
+        const int endCol = std::min(srcCount, floorDiv(width - 1 - originX, factor) + 1);
+        if (col >= endCol) {
+            std::fill_n(row, width, k_background);
+            return;
+        }
+
+        const int colStart = originX + col * factor;
+        int x = std::max(colStart, 0);
+        std::fill_n(row, x, k_background);
+
+        // Source pixel partially clipped by the left edge
+        if (colStart < 0) {
+            const int end = std::min(width, colStart + factor);
+            std::fill(row + x, row + end, src[col]);
+            x = end;
+            col++;
+        }
+
+        // Source pixels fully within the target
+        const int fullCount = std::min(endCol - col, (width - x) / factor);
+        if (fullCount > 0) {
+            expand(src + col, fullCount, factor, row + x);
+            x += fullCount * factor;
+            col += fullCount;
+        }
+
+        // Source pixel partially clipped by the right edge
+        if (col < endCol && x < width) {
+            const int end = std::min(width, x + factor);
+            std::fill(row + x, row + end, src[col]);
+            x = end;
+        }
+
+        std::fill(row + x, row + width, k_background);
+    }
+}
+
+
+void PixelZoom::zoom(const QImage& source, const QRect& sourceRect, int factor, const QPoint& origin,
+                     QImage& target, const Overlay& overlay) {
+    static const ExpandFunc expand = selectExpand();
+
+    const int width = target.width();
+    const int height = target.height();
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // A row of the enlarged source is built once and then copied to each target row it covers, so that the
+    // overlay can be drawn directly into the target rows.
+    thread_local std::vector<QRgb> rowBuffer;
+    rowBuffer.resize(static_cast<std::size_t>(width));
+
+    const std::size_t rowBytes = static_cast<std::size_t>(width) * sizeof(QRgb);
+    int bufferedSourceY = -1;
+
+    for (int y = 0; y < height; y++) {
+        auto* row = reinterpret_cast<QRgb*>(target.scanLine(y));
+        const int sourceY = sourceRect.isEmpty() ? -1 : floorDiv(y - origin.y(), factor);
+
+        if (sourceY >= 0 && sourceY < sourceRect.height()) {
+            if (sourceY != bufferedSourceY) {
+                const auto* src = reinterpret_cast<const QRgb*>(source.constScanLine(sourceRect.y() + sourceY))
+                                  + sourceRect.x();
+                expandRow(expand, src, sourceRect.width(), factor, origin.x(), rowBuffer.data(), width);
+                bufferedSourceY = sourceY;
+            }
+            std::memcpy(row, rowBuffer.data(), rowBytes);
+        } else {
+            std::fill_n(row, width, k_background);
+        }
+
+        drawOverlay(row, width, y, overlay);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QPoint>
+#include <QLine>
+#include <QRgb>
+
+
+/// Enlarges images by an integer factor using pixel replication (i.e. nearest neighbor scaling). This avoids
+/// drawing the image through a scaling QPainter transform, which uses a generic transformed image path regardless
+/// of the scale factor. Rows are expanded using SSE2 and, when the processor supports it, AVX2 instructions. A
+/// scalar implementation is used on other processors.
+///
+namespace PixelZoom {
+
+    /// Lines and an outlined rectangle drawn over the zoomed image as it is written.
+    ///
+    struct Overlay {
+        const QLine* lines { nullptr };     ///< Horizontal and vertical lines to draw. Other lines are ignored.
+        int lineCount { 0 };                ///< Number of lines
+        QRgb lineColor { 0 };               ///< Color of the lines
+        QRect marker;                       ///< Rectangle to outline. A null rectangle is not drawn.
+        QRgb markerColor { 0 };             ///< Color of the rectangle outline
+    };
+
+    /// Writes an enlarged portion of an image into a target image. Every pixel of the target image is written.
+    /// Target pixels not covered by the enlarged source are set to black. The overlay lines and rectangle outline
+    /// are drawn with the same pixel coverage as a one pixel wide, non-antialiased QPainter pen. That is, a
+    /// rectangle outline covers marker.width() + 1 by marker.height() + 1 pixels.
+    ///
+    /// @param[in] source Image to enlarge. Must be in the QImage::Format_RGB32 format.
+    /// @param[in] sourceRect Portion of the source image to enlarge. Must be within the source image.
+    /// @param[in] factor Enlargement factor. Must be at least 1.
+    /// @param[in] origin Position in the target image of the top left corner of the enlarged source rectangle.
+    ///     May be outside the target image.
+    /// @param[out] target Image to receive the enlarged source. Must be in the QImage::Format_RGB32 format.
+    /// @param[in] overlay Lines and rectangle outline to draw over the enlarged source
+    ///
+    void zoom(const QImage& source, const QRect& sourceRect, int factor, const QPoint& origin, QImage& target,
+              const Overlay& overlay = {});
+}
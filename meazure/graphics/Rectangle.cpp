@@ -19,6 +19,7 @@
 #include <QPainter>
 #include <QSize>
 #include <QLine>
+#include <QPainterPath>
 
 
 Rectangle::Rectangle(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, double offset,
@@ -38,7 +39,7 @@ Rectangle::Rectangle(const ScreenInfo* screenInfo, const UnitsProvider* unitsPro
             &Rectangle::setLineWidth);
     connect(m_screenInfo, &ScreenInfo::resolutionChanged, this, [this]() {
         setPosition(m_start, m_end);
-        repaint();
+        schedulePaint();
     });
 }
 
@@ -50,7 +51,7 @@ void Rectangle::colorChanged(Colors::Item item, QRgb color) {
 
 void Rectangle::setColor(QRgb color) {
     m_pen.setColor(color);
-    repaint();
+    schedulePaint();
 }
 
 void Rectangle::setLineWidth(int width) {
@@ -61,7 +62,8 @@ void Rectangle::setLineWidth(int width) {
 
 void Rectangle::setOffset(double offset) {
     m_offset = offset;
-    repaint();
+    updateMask();
+    schedulePaint();
 }
 
 void Rectangle::setPosition(const QPoint& start, const QPoint& end) {
@@ -79,12 +81,11 @@ void Rectangle::setPosition(const QPoint& start, const QPoint& end) {
     //
     windowRect.adjust(-m_lineWidth, -m_lineWidth, m_lineWidth, m_lineWidth);
 
-    setGeometry(windowRect);
+    setGraphicGeometry(windowRect);
+    updateMask();
 }
 
-void Rectangle::paintEvent(QPaintEvent*) {
-    static constexpr int k_numSides = 4;
-
+std::array<QLine, Rectangle::k_numSides> Rectangle::getSides() const {
     QSize offset(0, 0);
 
     if (m_offset > 0.0) {
@@ -94,29 +95,41 @@ void Rectangle::paintEvent(QPaintEvent*) {
         offset = m_unitsProvider->convertToPixels(InchesId, screenRes, m_offset, 1);
     }
 
-    QPainter painter(this);
-    painter.setPen(m_pen);
-
     // Compensate for margin.
     //
     const int right = width() - m_lineWidth - 1;
     const int bottom = height() - m_lineWidth - 1;
 
     if ((m_start.x() > m_end.x()) != (m_start.y() > m_end.y())) {
-        const QLine lines[k_numSides] = {
+        return {
                 QLine(m_lineWidth, m_lineWidth, right - offset.width(), m_lineWidth),    // Top
                 QLine(m_lineWidth, m_lineWidth, m_lineWidth, bottom - offset.height()),  // Left
                 QLine(right, m_lineWidth + offset.height(), right, bottom),              // Right
                 QLine(m_lineWidth + offset.width(), bottom, right, bottom)               // Bottom
         };
-        painter.drawLines(lines, k_numSides);
-    } else {
-        const QLine lines[k_numSides] = {
-                QLine(m_lineWidth + offset.width(), m_lineWidth, right, m_lineWidth),    // Top
-                QLine(m_lineWidth, m_lineWidth + offset.height(), m_lineWidth, bottom),  // Left
-                QLine(right, m_lineWidth, right, bottom - offset.height()),              // Right
-                QLine(m_lineWidth, bottom, right - offset.width(), bottom)               // Bottom
-        };
-        painter.drawLines(lines, k_numSides);
     }
+
+    return {
+            QLine(m_lineWidth + offset.width(), m_lineWidth, right, m_lineWidth),    // Top
+            QLine(m_lineWidth, m_lineWidth + offset.height(), m_lineWidth, bottom),  // Left
+            QLine(right, m_lineWidth, right, bottom - offset.height()),              // Right
+            QLine(m_lineWidth, bottom, right - offset.width(), bottom)               // Bottom
+    };
+}
+
+void Rectangle::updateMask() {
+    QPainterPath outline;
+    for (const QLine& side : getSides()) {
+        outline.moveTo(side.p1());
+        outline.lineTo(side.p2());
+    }
+    setOutlineMask(outline, m_lineWidth);
+}
+
+void Rectangle::paintEvent(QPaintEvent*) {
+    const std::array<QLine, k_numSides> sides = getSides();
+
+    QPainter painter(this);
+    painter.setPen(m_pen);
+    painter.drawLines(sides.data(), k_numSides);
 }
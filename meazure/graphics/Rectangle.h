@@ -24,6 +24,8 @@
 #include <meazure/units/UnitsProvider.h>
 #include <QObject>
 #include <QPen>
+#include <QLine>
+#include <array>
 
 
 /// A rectangle graphical element. The rectangle is used by the Rectangle measurement tool. The rectangle is
@@ -84,6 +86,16 @@ private slots:
     void colorChanged(Colors::Item item, QRgb color);
 
 private:
+    static constexpr int k_numSides { 4 };
+
+    /// Obtains the sides of the rectangle to draw, in widget coordinates. The sides are shortened by the offset.
+    ///
+    /// @return Top, left, right and bottom sides of the rectangle.
+    ///
+    [[nodiscard]] std::array<QLine, k_numSides> getSides() const;
+
+    void updateMask();
+
     double m_offset;
     int m_lineWidth;
     QPen m_pen;
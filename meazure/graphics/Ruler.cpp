@@ -21,6 +21,7 @@
 #include <QPainter>
 #include <QGraphicsOpacityEffect>
 #include <utility>
+#include <cstddef>
 
 
 Ruler::Ruler(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, bool flip,
@@ -46,7 +47,7 @@ Ruler::Ruler(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, b
     connect(Colors::getChangeNotifier(), &Colors::ChangeNotifier::colorChanged, this, &Ruler::colorChanged);
     connect(m_screenInfo, &ScreenInfo::resolutionChanged, this, [this]() {
         setPosition(m_origin, m_length, m_angle);
-        repaint();
+        schedulePaint();
     });
 
     m_font.setLetterSpacing(QFont::PercentageSpacing, 120);
@@ -72,7 +73,7 @@ void Ruler::setColors(QRgb background, QRgb border) {
     m_backgroundBrush.setColor(background);
     m_linePen.setColor(border);
 
-    repaint();
+    schedulePaint();
 }
 
 void Ruler::setOpacity(int opacityPercent) {
@@ -102,7 +103,7 @@ void Ruler::setPosition(const QPoint& origin, int length, int angle) {
 
     const QRect globalRulerRect(origin.x(), m_flip ? origin.y() : (origin.y() - rulerThk), m_length, rulerThk);
     const QRect boundingRect = Geometry::rotateAround(m_angle, origin).mapRect(globalRulerRect);
-    setGeometry(boundingRect);
+    setGraphicGeometry(boundingRect);
 
     const int xoLocal = origin.x() - x();
     const int yoLocal = origin.y() - y();
@@ -121,12 +122,46 @@ int Ruler::convertToPixels(const QSizeF& res, double angleFrac, double value, in
 }
 
 void Ruler::setIndicator(int indicatorIdx, int position) {
-    m_indicators.at(indicatorIdx) = position;
-    repaint();
+    if (m_indicators.at(indicatorIdx) != position) {
+        m_indicators.at(indicatorIdx) = position;
+        schedulePaint();
+    }
 }
 
-void Ruler::paintEvent(QPaintEvent*) {
-    QPainter painter(this);
+void Ruler::refresh() {
+    m_layerValid = false;
+    schedulePaint();
+}
+
+Ruler::LayerKey Ruler::createLayerKey() const {
+    LayerKey key;
+    key.length = m_length;
+    key.angle = m_angle;
+    key.unitsId = m_unitsProvider->getLinearUnitsId();
+    key.precision = m_unitsProvider->getLinearUnits()->getDisplayPrecisions().at(Width);
+    key.background = m_backgroundBrush.color().rgba();
+    key.border = m_linePen.color().rgba();
+    key.size = size();
+    key.pixelRatio = devicePixelRatioF();
+
+    // The tick spacing depends on the screen containing the ruler, and the ruler is clipped to each screen.
+    for (int idx = 0; idx < m_screenInfo->getNumScreens(); idx++) {
+        const QRect intersectRect = m_screenInfo->getScreenRect(idx).intersected(geometry());
+        if (!intersectRect.isEmpty()) {
+            const QRect clipRect(intersectRect.topLeft() - geometry().topLeft(), intersectRect.size());
+            key.parts.push_back({ clipRect, intersectRect, m_screenInfo->getScreenRes(idx) });
+        }
+    }
+
+    return key;
+}
+
+void Ruler::renderLayer() {
+    m_layer = QPixmap(m_layerKey.size * m_layerKey.pixelRatio);
+    m_layer.setDevicePixelRatio(m_layerKey.pixelRatio);
+    m_layer.fill(Qt::transparent);
+
+    QPainter painter(&m_layer);
     painter.setFont(m_font);
     painter.setRenderHint(QPainter::Antialiasing);
 
@@ -135,14 +170,8 @@ void Ruler::paintEvent(QPaintEvent*) {
 
     const int majorTickCount = m_unitsProvider->getMajorTickCount();
 
-    for (int idx = 0; idx < m_screenInfo->getNumScreens(); idx++) {
-        const QRect intersectRect = m_screenInfo->getScreenRect(idx).intersected(geometry());
-        if (intersectRect.isEmpty()) {
-            return;
-        }
-
-        const QSizeF res = m_screenInfo->getScreenRes(idx);
-        const QSizeF minorTickIncr = m_unitsProvider->getMinorTickIncr(intersectRect);
+    for (const ScreenPart& part : m_layerKey.parts) {
+        const QSizeF minorTickIncr = m_unitsProvider->getMinorTickIncr(part.screenRect);
         const double effectiveMinorTickIncr = MathUtils::linearInterpolate(minorTickIncr.width(),
                                                                            minorTickIncr.height(),
                                                                            m_angleFraction);
@@ -153,7 +182,7 @@ void Ruler::paintEvent(QPaintEvent*) {
         int tick;       // NOLINT(cppcoreguidelines-init-variables)
         double p;       // NOLINT(cppcoreguidelines-init-variables)
         for (l = 0, p = 0.0, tick = 0; l < m_length;
-             tick++, p += effectiveMinorTickIncr, l = convertToPixels(res, m_angleFraction, p, 1)) {
+             tick++, p += effectiveMinorTickIncr, l = convertToPixels(part.res, m_angleFraction, p, 1)) {
             const int x = m_rulerRect.x() + l;
             const bool isMajorTick = ((tick % majorTickCount) == 0);
             const int tickHeight = isMajorTick ? m_majorTickHeight : m_minorTickHeight;
@@ -171,17 +200,8 @@ void Ruler::paintEvent(QPaintEvent*) {
             }
         }
 
-        // Indicators
-        for (const int indicatorX : m_indicators) {
-            if (indicatorX != k_unusedIndicator) {
-                const int x = m_rulerRect.x() + indicatorX;
-                lines.emplace_back(x, m_rulerRect.top(), x, m_rulerRect.bottom());
-            }
-        }
-
-        const QRect clipRect(intersectRect.topLeft() - geometry().topLeft(), intersectRect.size());
         painter.save();
-        painter.setClipRect(clipRect);
+        painter.setClipRect(part.clipRect);
         painter.setTransform(m_rulerTransform);
         painter.drawRect(m_rulerRect);
         painter.drawLines(lines.data(), static_cast<int>(lines.size()));
@@ -211,3 +231,39 @@ void Ruler::paintEvent(QPaintEvent*) {
         painter.restore();
     }
 }
+
+void Ruler::paintEvent(QPaintEvent*) {
+    LayerKey key = createLayerKey();
+    if (!m_layerValid || !(key == m_layerKey)) {
+        m_layerKey = std::move(key);
+        renderLayer();
+        m_layerValid = true;
+    }
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_layer);
+
+    // Indicators
+    std::array<QLine, 3> lines;
+    int lineCount = 0;
+    for (const int indicatorX : m_indicators) {
+        if (indicatorX != k_unusedIndicator) {
+            const int x = m_rulerRect.x() + indicatorX;
+            lines.at(static_cast<std::size_t>(lineCount++)) = QLine(x, m_rulerRect.top(), x, m_rulerRect.bottom());
+        }
+    }
+    if (lineCount == 0) {
+        return;
+    }
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(m_linePen);
+
+    for (const ScreenPart& part : m_layerKey.parts) {
+        painter.save();
+        painter.setClipRect(part.clipRect);
+        painter.setTransform(m_rulerTransform);
+        painter.drawLines(lines.data(), lineCount);
+        painter.restore();
+    }
+}
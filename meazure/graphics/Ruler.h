@@ -28,7 +28,10 @@
 #include <QBrush>
 #include <QTransform>
 #include <QFontMetrics>
+#include <QPixmap>
+#include <QSizeF>
 #include <array>
+#include <vector>
 
 
 
@@ -38,6 +41,10 @@
 /// Multiple position indicators can be displayed on the face of the ruler. These indicators can be used to show the
 /// current position of crosshairs and other measurement points.
 ///
+/// The ruler body (i.e. the outline, tick marks and labels) is rendered into a pixmap, which is reused until the
+/// length, angle, units, precision, colors or screen resolution of the ruler change. Moving an indicator therefore
+/// only requires the pixmap to be drawn and the indicator lines to be drawn over it.
+///
 class Ruler : public Graphic {
 
     Q_OBJECT
@@ -58,6 +65,11 @@ public:
 
     void setIndicator(int indicatorIdx, int position);
 
+    /// Redraws the ruler body. Call this method when the units have changed in a way that is not reflected by the
+    /// units identifier or precision (e.g. the custom units conversion factor has changed).
+    ///
+    void refresh();
+
     int getRulerThk() const { return m_rulerRect.height(); }
 
 protected:
@@ -77,8 +89,42 @@ private:
     static constexpr double k_labelTopMargin { 0.1 };     ///< Space between label top and ruler border, inches
     static constexpr int k_labelTopMinMargin { 3 };       ///< Minimum space between label top and ruler border, pixels
 
+    /// Portion of the ruler on a screen.
+    ///
+    struct ScreenPart {
+        QRect clipRect;                 ///< Portion of the ruler on the screen, in widget coordinates
+        QRect screenRect;               ///< Portion of the ruler on the screen, in global coordinates
+        QSizeF res;                     ///< Resolution of the screen
+
+        bool operator==(const ScreenPart& other) const {
+            return clipRect == other.clipRect && screenRect.size() == other.screenRect.size() && res == other.res;
+        }
+    };
+
+    /// Everything the rendering of the ruler body depends upon.
+    ///
+    struct LayerKey {
+        int length { 0 };
+        int angle { 0 };
+        LinearUnitsId unitsId { PixelsId };
+        int precision { 0 };
+        QRgb background { 0 };
+        QRgb border { 0 };
+        QSize size;
+        qreal pixelRatio { 1.0 };
+        std::vector<ScreenPart> parts;
+
+        bool operator==(const LayerKey& other) const {
+            return length == other.length && angle == other.angle && unitsId == other.unitsId
+                && precision == other.precision && background == other.background && border == other.border
+                && size == other.size && pixelRatio == other.pixelRatio && parts == other.parts;
+        }
+    };
+
     int convertToPixels(LinearUnitsId unitsId, const QSizeF& res, double angleFrac, double value, int minValue);
     int convertToPixels(const QSizeF& res, double angleFrac, double value, int minValue);
+    [[nodiscard]] LayerKey createLayerKey() const;
+    void renderLayer();
 
     QBrush m_backgroundBrush;                           ///< Ruler background brush
     QPen m_linePen;                                     ///< Ruler border, lines and label drawing pen
@@ -98,4 +144,7 @@ private:
     std::array<int, 3> m_indicators {                   ///< Positions of the ruler indicators
         k_unusedIndicator, k_unusedIndicator, k_unusedIndicator
     };
+    QPixmap m_layer;                                    ///< Prerendered ruler body
+    LayerKey m_layerKey;                                ///< Properties with which the ruler body was rendered
+    bool m_layerValid { false };
 };
@@ -18,6 +18,13 @@
 #include "X11GraphicTag.h"
 #include <meazure/utils/x11/XlibUtils.h>
 #include <X11/Xatom.h>
+#include <QMutex>
+#include <QMutexLocker>
+#include <array>
+#include <atomic>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
 
 
 static Atom MEA_GFX = None;
@@ -29,11 +36,135 @@ static void ensureIntern() {
     }
 }
 
-bool X11GraphicTag::isGraphicWindow(unsigned long windowId) {
-    if (windowId == None) {
-        return false;
-    }
 
+namespace {
+
+    /// Set of the native window identifiers of the Meazure graphic windows. The set is an open addressing hash
+    /// table of atomic slots. Lookups probe the slots without locking and are therefore safe to perform from any
+    /// thread (e.g. the window tracking thread). Modifications are serialized by a mutex. Removed identifiers are
+    /// replaced by a marker so that the probe sequences of the remaining identifiers are not broken.
+    ///
+    class GraphicWindowSet {
+    public:
+        GraphicWindowSet() {
+            for (std::atomic<unsigned long>& slot : m_slots) {
+                slot.store(k_empty, std::memory_order_relaxed);
+            }
+        }
+
+        /// Indicates whether the set contains the specified window.
+        ///
+        /// @param[in] windowId Native window identifier
+        /// @return true if the window is in the set.
+        ///
+        [[nodiscard]] bool contains(unsigned long windowId) const {
+            std::size_t index = hash(windowId);
+            for (std::size_t i = 0; i < k_capacity; i++) {
+                const unsigned long slot = m_slots[index].load(std::memory_order_acquire);
+                if (slot == windowId) {
+                    return true;
+                }
+                if (slot == k_empty) {
+                    return false;
+                }
+                index = (index + 1) & (k_capacity - 1);
+            }
+            return false;
+        }
+
+        /// Indicates whether the set ran out of room, in which case it cannot be relied upon.
+        ///
+        [[nodiscard]] bool isOverflowed() const {
+            return m_overflowed.load(std::memory_order_acquire);
+        }
+
+        /// Sets the window of the specified widget, replacing any window previously set for the widget.
+        ///
+        void setWindow(const QWidget* widget, unsigned long windowId) {
+            const QMutexLocker locker(&m_mutex);
+
+            const auto iter = m_widgetWindows.find(widget);
+            if (iter != m_widgetWindows.end()) {
+                if (iter->second == windowId) {
+                    return;
+                }
+                remove(iter->second);
+            }
+
+            m_widgetWindows[widget] = windowId;
+            insert(windowId);
+        }
+
+        /// Removes the window of the specified widget.
+        ///
+        void removeWindow(const QWidget* widget) {
+            const QMutexLocker locker(&m_mutex);
+
+            const auto iter = m_widgetWindows.find(widget);
+            if (iter != m_widgetWindows.end()) {
+                remove(iter->second);
+                m_widgetWindows.erase(iter);
+            }
+        }
+
+    private:
+        static constexpr std::size_t k_capacity { 256 };           // Must be a power of 2
+        static constexpr unsigned long k_empty { 0 };
+        static constexpr unsigned long k_removed { ~0UL };
+
+        static std::size_t hash(unsigned long windowId) {
+            // Fibonacci hashing spreads the sequentially allocated X identifiers across the table.
+            const uint64_t product = static_cast<uint64_t>(windowId) * UINT64_C(0x9E3779B97F4A7C15);
+            return static_cast<std::size_t>(product >> 56U) & (k_capacity - 1);
+        }
+
+        void insert(unsigned long windowId) {
+            std::size_t index = hash(windowId);
+            for (std::size_t i = 0; i < k_capacity; i++) {
+                const unsigned long slot = m_slots[index].load(std::memory_order_relaxed);
+                if (slot == k_empty || slot == k_removed) {
+                    m_slots[index].store(windowId, std::memory_order_release);
+                    return;
+                }
+                index = (index + 1) & (k_capacity - 1);
+            }
+
+            m_overflowed.store(true, std::memory_order_release);
+        }
+
+        void remove(unsigned long windowId) {
+            std::size_t index = hash(windowId);
+            for (std::size_t i = 0; i < k_capacity; i++) {
+                const unsigned long slot = m_slots[index].load(std::memory_order_relaxed);
+                if (slot == windowId) {
+                    m_slots[index].store(k_removed, std::memory_order_release);
+                    return;
+                }
+                if (slot == k_empty) {
+                    return;
+                }
+                index = (index + 1) & (k_capacity - 1);
+            }
+        }
+
+        std::array<std::atomic<unsigned long>, k_capacity> m_slots;
+        std::atomic<bool> m_overflowed { false };
+        QMutex m_mutex;
+        std::unordered_map<const QWidget*, unsigned long> m_widgetWindows;
+    };
+}
+
+
+static GraphicWindowSet& graphicWindows() {
+    static GraphicWindowSet windows;
+    return windows;
+}
+
+
+/// Reads the MEA_GFX property of the specified window. This is only used if the set of graphic windows has run out
+/// of room.
+///
+static bool hasGraphicProperty(unsigned long windowId) {
     ensureIntern();
 
     Atom typeReturn = None;
@@ -52,16 +183,38 @@ bool X11GraphicTag::isGraphicWindow(unsigned long windowId) {
     return found;
 }
 
+bool X11GraphicTag::isGraphicWindow(unsigned long windowId) {
+    if (windowId == None) {
+        return false;
+    }
+
+    GraphicWindowSet& windows = graphicWindows();
+    if (windows.contains(windowId)) {
+        return true;
+    }
+
+    return windows.isOverflowed() && hasGraphicProperty(windowId);
+}
+
 void X11GraphicTag::processEvents(const QWidget* target, const QEvent* event) {
     if (event->type() == QEvent::WinIdChange) {
         if (target->parent() == nullptr) {
             const auto win = static_cast<Window>(target->effectiveWinId());
             if (win != None) {
+                graphicWindows().setWindow(target, win);
+
+                // The property allows other X clients to recognize Meazure graphic windows.
                 ensureIntern();
 
                 const uint8_t value = 1;
                 XChangeProperty(Xlib::qtDisplay(), win, MEA_GFX, XA_CARDINAL, 8, PropModeReplace, &value, 1);
+            } else {
+                graphicWindows().removeWindow(target);
             }
         }
     }
 }
+
+void X11GraphicTag::removeWindow(const QWidget* target) {
+    graphicWindows().removeWindow(target);
+}
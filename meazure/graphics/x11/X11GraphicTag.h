@@ -20,11 +20,15 @@
 #include <QWidget>
 
 
-/// X11 implementation of the Meazure graphic window identifier tag.
+/// X11 implementation of the Meazure graphic window identifier tag. The native identifiers of the Meazure graphic
+/// windows are kept in an in-process set so that they can be recognized without any X traffic. The set can be read
+/// from any thread without locking. In addition, the MEA_GFX property is set on each graphic window so that other
+/// X clients can recognize them.
 ///
 namespace X11GraphicTag {
 
-    /// Indicates there the specified window is a Meazure graphic window.
+    /// Indicates whether the specified window is a Meazure graphic window of this process. This function may be
+    /// called from any thread.
     ///
     /// @param[in] windowId Native window identifier
     /// @return true if the specified window is a Meazure graphic window.
@@ -37,4 +41,11 @@ namespace X11GraphicTag {
     /// @param[in] event Event to process
     ///
     void processEvents(const QWidget* target, const QEvent* event);
+
+    /// Removes the window of the specified widget from the set of Meazure graphic windows. Call this method when
+    /// the widget is destroyed.
+    ///
+    /// @param[in] target Widget being destroyed
+    ///
+    void removeWindow(const QWidget* target);
 };
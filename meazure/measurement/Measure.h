@@ -0,0 +1,162 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <meazure/utils/Geometry.h>
+#include <QPoint>
+#include <QPointF>
+#include <QSizeF>
+
+
+/// Calculations of the measurements made by the radio tools. The calculations are shared by the tools and the
+/// MeasurementEngine so that both make identical measurements.
+///
+/// The calculations are performed using the specified linear and angular units. Any class providing the following
+/// methods can be used, such as a UnitsProvider or a LinearUnits and AngularUnits pair:
+///
+/// - Linear units: QPointF convertCoord(const QPoint&) and QSizeF getWidthHeight(const QPoint&, const QPoint&)
+/// - Angular units: double convertAngle(double)
+///
+namespace Measure {
+
+    /// Measurements of the extent between two positions, as made by the Line, Rectangle and Window tools.
+    ///
+    struct Extent {
+        QPointF coord1;             ///< Position 1 coordinates
+        QPointF coord2;             ///< Position 2 coordinates
+        QSizeF widthHeight;         ///< Width and height of the rectangle formed by the positions
+        double distance;            ///< Distance between the positions
+        double angle;               ///< Angle of the line from position 1 to position 2
+        double area;                ///< Area of the rectangle formed by the positions
+        double aspect;              ///< Aspect ratio of the rectangle formed by the positions
+    };
+
+    /// Measurements of a circle, as made by the Circle tool.
+    ///
+    struct Circle {
+        QPointF coordCenter;        ///< Center coordinates
+        QPointF coordPerimeter;     ///< Perimeter point coordinates
+        QSizeF widthHeight;         ///< Width and height of the circle (i.e. the diameter)
+        double radius;              ///< Radius of the circle
+        double angle;               ///< Angle of the line from the center to the perimeter point
+        double area;                ///< Area of the circle
+        double aspect;              ///< Aspect ratio of the circle
+    };
+
+    /// Measurements of an angle, as made by the Angle tool.
+    ///
+    struct Angle {
+        QPointF coord1;             ///< Coordinates of the end of the first line
+        QPointF coord2;             ///< Coordinates of the end of the second line
+        QPointF coordV;             ///< Vertex coordinates
+        double angle;               ///< Angle between the lines
+    };
+
+    /// Measures the extent between two positions whose coordinates have already been converted (e.g. in a batch).
+    ///
+    /// @tparam LINEAR_UNITS Type providing the linear units methods
+    /// @tparam ANGULAR_UNITS Type providing the angular units methods
+    /// @param[in] linearUnits Units for the coordinates, lengths and area
+    /// @param[in] angularUnits Units for the angle
+    /// @param[in] p1 Position 1, in pixels
+    /// @param[in] p2 Position 2, in pixels
+    /// @param[in] coord1 Position 1 converted to the linear units
+    /// @param[in] coord2 Position 2 converted to the linear units
+    /// @return Measurements of the extent.
+    ///
+    template<class LINEAR_UNITS, class ANGULAR_UNITS>
+    Extent measureExtent(const LINEAR_UNITS& linearUnits, const ANGULAR_UNITS& angularUnits,
+                         const QPoint& p1, const QPoint& p2, const QPointF& coord1, const QPointF& coord2) {
+        const QSizeF wh = linearUnits.getWidthHeight(p1, p2);
+        return {
+            coord1,
+            coord2,
+            wh,
+            Geometry::hypot(wh),
+            angularUnits.convertAngle(Geometry::angle(coord1, coord2)),
+            Geometry::area(wh),
+            Geometry::aspectRatio(wh)
+        };
+    }
+
+    /// Measures the extent between two positions.
+    ///
+    /// @tparam LINEAR_UNITS Type providing the linear units methods
+    /// @tparam ANGULAR_UNITS Type providing the angular units methods
+    /// @param[in] linearUnits Units for the coordinates, lengths and area
+    /// @param[in] angularUnits Units for the angle
+    /// @param[in] p1 Position 1, in pixels
+    /// @param[in] p2 Position 2, in pixels
+    /// @return Measurements of the extent.
+    ///
+    template<class LINEAR_UNITS, class ANGULAR_UNITS>
+    Extent measureExtent(const LINEAR_UNITS& linearUnits, const ANGULAR_UNITS& angularUnits,
+                         const QPoint& p1, const QPoint& p2) {
+        return measureExtent(linearUnits, angularUnits, p1, p2, linearUnits.convertCoord(p1),
+                             linearUnits.convertCoord(p2));
+    }
+
+    /// Measures a circle.
+    ///
+    /// @tparam LINEAR_UNITS Type providing the linear units methods
+    /// @tparam ANGULAR_UNITS Type providing the angular units methods
+    /// @param[in] linearUnits Units for the coordinates, lengths and area
+    /// @param[in] angularUnits Units for the angle
+    /// @param[in] center Center of the circle, in pixels
+    /// @param[in] perimeter Point on the perimeter of the circle, in pixels
+    /// @return Measurements of the circle.
+    ///
+    template<class LINEAR_UNITS, class ANGULAR_UNITS>
+    Circle measureCircle(const LINEAR_UNITS& linearUnits, const ANGULAR_UNITS& angularUnits,
+                         const QPoint& center, const QPoint& perimeter) {
+        const QPointF coordCenter = linearUnits.convertCoord(center);
+        const QPointF coordPerimeter = linearUnits.convertCoord(perimeter);
+        const double radius = Geometry::hypot(coordPerimeter, coordCenter);
+        const double diameter = 2.0 * radius;
+        const QSizeF wh(diameter, diameter);
+        return {
+            coordCenter,
+            coordPerimeter,
+            wh,
+            radius,
+            angularUnits.convertAngle(Geometry::angle(coordCenter, coordPerimeter)),
+            Geometry::area(radius),
+            Geometry::aspectRatio(wh)
+        };
+    }
+
+    /// Measures an angle.
+    ///
+    /// @tparam LINEAR_UNITS Type providing the linear units methods
+    /// @tparam ANGULAR_UNITS Type providing the angular units methods
+    /// @param[in] linearUnits Units for the coordinates
+    /// @param[in] angularUnits Units for the angle
+    /// @param[in] vertex Vertex of the angle, in pixels
+    /// @param[in] p1 End of the first line of the angle, in pixels
+    /// @param[in] p2 End of the second line of the angle, in pixels
+    /// @return Measurements of the angle.
+    ///
+    template<class LINEAR_UNITS, class ANGULAR_UNITS>
+    Angle measureAngle(const LINEAR_UNITS& linearUnits, const ANGULAR_UNITS& angularUnits,
+                       const QPoint& vertex, const QPoint& p1, const QPoint& p2) {
+        const QPointF coord1 = linearUnits.convertCoord(p1);
+        const QPointF coord2 = linearUnits.convertCoord(p2);
+        const QPointF coordV = linearUnits.convertCoord(vertex);
+        return { coord1, coord2, coordV, angularUnits.convertAngle(Geometry::angle(coordV, coord1, coord2)) };
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MeasurementEngine.h"
+#include <QPointF>
+#include <vector>
+
+
+MeasurementEngine::MeasurementEngine(const ScreenInfoProvider* screenInfoProvider) :
+        m_pixelUnits(screenInfoProvider),
+        m_pointUnits(screenInfoProvider),
+        m_twipUnits(screenInfoProvider),
+        m_inchUnits(screenInfoProvider),
+        m_cmUnits(screenInfoProvider),
+        m_mmUnits(screenInfoProvider),
+        m_picaUnits(screenInfoProvider),
+        m_customUnits(screenInfoProvider),
+        m_currentLinearUnits(&m_pixelUnits),
+        m_currentAngularUnits(&m_degreeUnits) {
+    m_linearUnitsMap[m_pixelUnits.getUnitsId()] = &m_pixelUnits;
+    m_linearUnitsMap[m_pointUnits.getUnitsId()] = &m_pointUnits;
+    m_linearUnitsMap[m_twipUnits.getUnitsId()] = &m_twipUnits;
+    m_linearUnitsMap[m_inchUnits.getUnitsId()] = &m_inchUnits;
+    m_linearUnitsMap[m_cmUnits.getUnitsId()] = &m_cmUnits;
+    m_linearUnitsMap[m_mmUnits.getUnitsId()] = &m_mmUnits;
+    m_linearUnitsMap[m_picaUnits.getUnitsId()] = &m_picaUnits;
+    m_linearUnitsMap[m_customUnits.getUnitsId()] = &m_customUnits;
+
+    m_angularUnitsMap[m_degreeUnits.getUnitsId()] = &m_degreeUnits;
+    m_angularUnitsMap[m_radianUnits.getUnitsId()] = &m_radianUnits;
+}
+
+void MeasurementEngine::setLinearUnits(LinearUnitsId unitsId) {
+    m_currentLinearUnits = m_linearUnitsMap.at(unitsId);
+}
+
+void MeasurementEngine::setAngularUnits(AngularUnitsId unitsId) {
+    m_currentAngularUnits = m_angularUnitsMap.at(unitsId);
+}
+
+void MeasurementEngine::setOrigin(const QPoint& origin) {
+    for (const auto& unitsEntry : m_linearUnitsMap) {
+        unitsEntry.second->setOrigin(origin);
+    }
+}
+
+void MeasurementEngine::setInvertY(bool invertY) {
+    for (const auto& unitsEntry : m_linearUnitsMap) {
+        unitsEntry.second->setInvertY(invertY);
+    }
+}
+
+void MeasurementEngine::setSupplementalAngle(bool showSupplemental) {
+    for (const auto& unitsEntry : m_angularUnitsMap) {
+        unitsEntry.second->setSupplementalAngle(showSupplemental);
+    }
+}
+
+MeasurementSnapshot MeasurementEngine::measurePoint(const QPoint& pos) const {
+    MeasurementSnapshot snapshot;
+    snapshot.setXY1Position(m_currentLinearUnits->convertCoord(pos), pos);
+    return snapshot;
+}
+
+MeasurementSnapshot MeasurementEngine::measureLine(const QPoint& p1, const QPoint& p2) const {
+    MeasurementSnapshot snapshot;
+    setExtent(snapshot, p1, p2, Measure::measureExtent(*m_currentLinearUnits, *m_currentAngularUnits, p1, p2));
+    return snapshot;
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+void MeasurementEngine::measureLines(const QPoint* p1, const QPoint* p2, MeasurementSnapshot* snapshots,
+                                     int count) const {
+    if (count <= 0) {
+        return;
+    }
+
+    std::vector<QPointF> coords1(static_cast<std::size_t>(count));
+    std::vector<QPointF> coords2(static_cast<std::size_t>(count));
+    m_currentLinearUnits->convertCoords(p1, coords1.data(), count);
+    m_currentLinearUnits->convertCoords(p2, coords2.data(), count);
+
+    for (int i = 0; i < count; i++) {
+        MeasurementSnapshot& snapshot = snapshots[i];
+        snapshot = MeasurementSnapshot();
+        setExtent(snapshot, p1[i], p2[i],
+                  Measure::measureExtent(*m_currentLinearUnits, *m_currentAngularUnits, p1[i], p2[i],
+                                         coords1[static_cast<std::size_t>(i)],
+                                         coords2[static_cast<std::size_t>(i)]));
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+MeasurementSnapshot MeasurementEngine::measureCircle(const QPoint& center, const QPoint& perimeter) const {
+    const Measure::Circle circle = Measure::measureCircle(*m_currentLinearUnits, *m_currentAngularUnits, center,
+                                                          perimeter);
+
+    MeasurementSnapshot snapshot;
+    snapshot.setXY1Position(circle.coordPerimeter, perimeter);
+    snapshot.setXYVPosition(circle.coordCenter, center);
+    snapshot.setExtent(circle.widthHeight, circle.radius, circle.angle, circle.area, circle.aspect);
+    return snapshot;
+}
+
+MeasurementSnapshot MeasurementEngine::measureAngle(const QPoint& vertex, const QPoint& p1, const QPoint& p2) const {
+    const Measure::Angle angle = Measure::measureAngle(*m_currentLinearUnits, *m_currentAngularUnits, vertex, p1, p2);
+
+    MeasurementSnapshot snapshot;
+    snapshot.setXY1Position(angle.coord1, p1);
+    snapshot.setXY2Position(angle.coord2, p2);
+    snapshot.setXYVPosition(angle.coordV, vertex);
+    snapshot.setAngle(angle.angle);
+    return snapshot;
+}
+
+void MeasurementEngine::setExtent(MeasurementSnapshot& snapshot, const QPoint& p1, const QPoint& p2,
+                                  const Measure::Extent& extent) {
+    snapshot.setXY1Position(extent.coord1, p1);
+    snapshot.setXY2Position(extent.coord2, p2);
+    snapshot.setExtent(extent.widthHeight, extent.distance, extent.angle, extent.area, extent.aspect);
+}
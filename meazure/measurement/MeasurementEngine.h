@@ -0,0 +1,168 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "MeasurementSnapshot.h"
+#include "Measure.h"
+#include <meazure/units/Units.h>
+#include <meazure/units/CustomUnits.h>
+#include <meazure/environment/ScreenInfoProvider.h>
+#include <QPoint>
+#include <map>
+
+
+/// Calculates the measurements made by the radio tools (e.g. width, height, distance, angle, area, aspect ratio)
+/// from positions in pixels, without any tool windows or a display. Combined with a ScreenLayout, an engine can
+/// evaluate positions offline or in unit tests.
+///
+/// Measurements are made in the selected linear and angular units, taking into account the location of the origin
+/// and the orientation of the y-axis. Each measurement is returned as a snapshot with every measurement made by the
+/// corresponding tool marked as changed.
+///
+class MeasurementEngine {
+
+public:
+    /// Constructs an engine measuring in pixels and degrees, with the system origin and y-axis orientation.
+    ///
+    /// @param[in] screenInfoProvider Layout and resolution of the display screens
+    ///
+    explicit MeasurementEngine(const ScreenInfoProvider* screenInfoProvider);
+
+    MeasurementEngine(const MeasurementEngine&) = delete;
+    MeasurementEngine(MeasurementEngine&&) = delete;
+    MeasurementEngine& operator=(const MeasurementEngine&) = delete;
+
+    void setLinearUnits(LinearUnitsId unitsId);
+
+    [[nodiscard]] LinearUnitsId getLinearUnitsId() const {
+        return m_currentLinearUnits->getUnitsId();
+    }
+
+    [[nodiscard]] const LinearUnits* getLinearUnits() const {
+        return m_currentLinearUnits;
+    }
+
+    void setAngularUnits(AngularUnitsId unitsId);
+
+    [[nodiscard]] AngularUnitsId getAngularUnitsId() const {
+        return m_currentAngularUnits->getUnitsId();
+    }
+
+    [[nodiscard]] const AngularUnits* getAngularUnits() const {
+        return m_currentAngularUnits;
+    }
+
+    /// Obtains the custom units so that their scale can be specified before measuring in them.
+    ///
+    /// @return Custom units used when measuring in CustomId units.
+    ///
+    [[nodiscard]] CustomUnits* getCustomUnits() {
+        return &m_customUnits;
+    }
+
+    /// Sets the location of the origin for all linear units.
+    ///
+    /// @param[in] origin Location of the origin, in pixels.
+    ///
+    void setOrigin(const QPoint& origin);
+
+    /// Sets the orientation of the y-axis for all linear units.
+    ///
+    /// @param[in] invertY true if the y-axis increases upward from the origin.
+    ///
+    void setInvertY(bool invertY);
+
+    /// Indicates whether angles are measured as the included angle (default) or the supplemental angle.
+    ///
+    /// @param[in] showSupplemental true to measure the supplemental angle
+    ///
+    void setSupplementalAngle(bool showSupplemental);
+
+    /// Measures a position, as done by the Point and Cursor tools.
+    ///
+    /// @param[in] pos Position to measure, in pixels.
+    /// @return Snapshot containing the position 1 coordinates.
+    ///
+    [[nodiscard]] MeasurementSnapshot measurePoint(const QPoint& pos) const;
+
+    /// Measures the extent between two positions, as done by the Line and Rectangle tools.
+    ///
+    /// @param[in] p1 Position 1, in pixels.
+    /// @param[in] p2 Position 2, in pixels.
+    /// @return Snapshot containing the position 1 and 2 coordinates, and the width, height, distance, angle, area and
+    ///     aspect ratio of the extent.
+    ///
+    [[nodiscard]] MeasurementSnapshot measureLine(const QPoint& p1, const QPoint& p2) const;
+
+    /// Measures the extents between many pairs of positions. The measurements are the same as those made by
+    /// measureLine, but the positions are converted in batches.
+    ///
+    /// @param[in] p1 Position 1 of each extent, in pixels.
+    /// @param[in] p2 Position 2 of each extent, in pixels.
+    /// @param[out] snapshots Receives the measurements of each extent. Must have room for count snapshots.
+    /// @param[in] count Number of extents to measure.
+    ///
+    void measureLines(const QPoint* p1, const QPoint* p2, MeasurementSnapshot* snapshots, int count) const;
+
+    /// Measures a circle, as done by the Circle tool.
+    ///
+    /// @param[in] center Center of the circle, in pixels.
+    /// @param[in] perimeter Point on the perimeter of the circle, in pixels.
+    /// @return Snapshot containing the perimeter point as position 1, the center as the vertex, the radius as the
+    ///     distance, and the width, height, angle, area and aspect ratio of the circle.
+    ///
+    [[nodiscard]] MeasurementSnapshot measureCircle(const QPoint& center, const QPoint& perimeter) const;
+
+    /// Measures an angle, as done by the Angle tool.
+    ///
+    /// @param[in] vertex Vertex of the angle, in pixels.
+    /// @param[in] p1 End of the first line of the angle, in pixels.
+    /// @param[in] p2 End of the second line of the angle, in pixels.
+    /// @return Snapshot containing the position 1, position 2 and vertex coordinates, and the angle.
+    ///
+    [[nodiscard]] MeasurementSnapshot measureAngle(const QPoint& vertex, const QPoint& p1, const QPoint& p2) const;
+
+private:
+    using LinearUnitsMap = std::map<LinearUnitsId, LinearUnits*>;
+    using AngularUnitsMap = std::map<AngularUnitsId, AngularUnits*>;
+
+    /// Records the specified extent measurements between positions 1 and 2 in the snapshot.
+    ///
+    /// @param[out] snapshot Snapshot in which to record the measurements
+    /// @param[in] p1 Position 1, in pixels
+    /// @param[in] p2 Position 2, in pixels
+    /// @param[in] extent Measurements of the extent between the positions
+    ///
+    static void setExtent(MeasurementSnapshot& snapshot, const QPoint& p1, const QPoint& p2,
+                          const Measure::Extent& extent);
+
+    PixelUnits m_pixelUnits;
+    PointUnits m_pointUnits;
+    TwipUnits m_twipUnits;
+    InchUnits m_inchUnits;
+    CentimeterUnits m_cmUnits;
+    MillimeterUnits m_mmUnits;
+    PicaUnits m_picaUnits;
+    CustomUnits m_customUnits;
+    DegreeUnits m_degreeUnits;
+    RadianUnits m_radianUnits;
+    LinearUnits* m_currentLinearUnits;
+    AngularUnits* m_currentAngularUnits;
+    LinearUnitsMap m_linearUnitsMap;
+    AngularUnitsMap m_angularUnitsMap;
+};
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFlags>
+#include <QPointF>
+#include <QPoint>
+#include <QSizeF>
+
+
+/// Flags to indicate which measurements in a MeasurementSnapshot have changed.
+///
+enum MeasurementField {
+    XY1Changed          = 0x00000001,
+    XY2Changed          = 0x00000002,
+    XYVChanged          = 0x00000004,
+    WHChanged           = 0x00000008,
+    DistChanged         = 0x00000010,
+    AngleChanged        = 0x00000020,
+    AreaChanged         = 0x00000040,
+    AspectChanged       = 0x00000080,
+};
+
+Q_DECLARE_FLAGS(MeasurementFields, MeasurementField)
+Q_DECLARE_OPERATORS_FOR_FLAGS(MeasurementFields)
+
+
+/// The measurements made by a radio tool in a single step (e.g. one movement of a crosshair). Only the measurements
+/// indicated by the changed flags are valid. Coordinates, lengths and areas are in the current linear units, origin
+/// and y-axis direction, and angles are in the current angular units.
+///
+struct MeasurementSnapshot {
+    MeasurementFields changed;      ///< Measurements that are valid in the snapshot
+
+    QPointF coord1;                 ///< Position 1 coordinates
+    QPoint rawPos1;                 ///< Position 1 on the screen, in pixels
+    QPointF coord2;                 ///< Position 2 coordinates
+    QPoint rawPos2;                 ///< Position 2 on the screen, in pixels
+    QPointF coordV;                 ///< Vertex coordinates
+    QPoint rawPosV;                 ///< Vertex on the screen, in pixels
+    QSizeF widthHeight;             ///< Width and height
+    double distance { 0.0 };        ///< Length of a line, diagonal or radius
+    double angle { 0.0 };           ///< Angle
+    double area { 0.0 };            ///< Area
+    double aspect { 0.0 };          ///< Aspect ratio (width / height)
+
+    [[nodiscard]] bool hasChanged(MeasurementField field) const {
+        return changed.testFlag(field);
+    }
+
+    void setXY1Position(const QPointF& coord, const QPoint& rawPos) {
+        coord1 = coord;
+        rawPos1 = rawPos;
+        changed |= XY1Changed;
+    }
+
+    void setXY2Position(const QPointF& coord, const QPoint& rawPos) {
+        coord2 = coord;
+        rawPos2 = rawPos;
+        changed |= XY2Changed;
+    }
+
+    void setXYVPosition(const QPointF& coord, const QPoint& rawPos) {
+        coordV = coord;
+        rawPosV = rawPos;
+        changed |= XYVChanged;
+    }
+
+    /// Sets the measurements that are derived from the extent of a tool.
+    ///
+    void setExtent(const QSizeF& wh, double dist, double ang, double ar, double asp) {
+        widthHeight = wh;
+        distance = dist;
+        angle = ang;
+        area = ar;
+        aspect = asp;
+        changed |= WHChanged | DistChanged | AngleChanged | AreaChanged | AspectChanged;
+    }
+
+    void setAngle(double ang) {
+        angle = ang;
+        changed |= AngleChanged;
+    }
+};
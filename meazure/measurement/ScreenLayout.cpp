@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ScreenLayout.h"
+#include <utility>
+
+
+ScreenLayout::ScreenLayout(std::vector<Screen> screens) : m_screens(std::move(screens)) {
+    std::vector<QRect> rects;
+    for (const Screen& screen : m_screens) {
+        rects.push_back(screen.rect);
+        m_screenRects.push_back(&screen.rect);
+        m_virtualRect = m_virtualRect.united(screen.rect);
+    }
+
+    m_screenIndex = Geometry::RectIndex(std::move(rects));
+}
+
+int ScreenLayout::getNumScreens() const {
+    return static_cast<int>(m_screens.size());
+}
+
+int ScreenLayout::screenForPoint(const QPoint& point) const {
+    return m_screenIndex.find(point);
+}
+
+int ScreenLayout::screenForRect(const QRect& rect) const {
+    return m_screenIndex.findBestOverlap(rect);
+}
+
+int ScreenLayout::screenForWindow(const QWidget*) const {
+    return -1;
+}
+
+QPoint ScreenLayout::getCenter() const {
+    return m_screens.empty() ? QPoint() : m_screens.front().rect.center();
+}
+
+QRect ScreenLayout::getVirtualRect() const {
+    return m_virtualRect;
+}
+
+QRect ScreenLayout::getAvailableVirtualRect() const {
+    return m_virtualRect;
+}
+
+QRect ScreenLayout::getScreenRect(int screenIndex) const {
+    return isValidScreen(screenIndex) ? m_screens[screenIndex].rect : QRect();
+}
+
+QSizeF ScreenLayout::getPlatformScale(int screenIndex) const {
+    return isValidScreen(screenIndex) ? QSizeF(1.0, 1.0) : QSizeF();
+}
+
+void ScreenLayout::getScreenRes(int screenIndex, bool& useManualRes, QSizeF& manualRes) const {
+    if (isValidScreen(screenIndex)) {
+        useManualRes = true;
+        manualRes = m_screens[screenIndex].res;
+    }
+}
+
+QSizeF ScreenLayout::getScreenRes(int screenIndex) const {
+    return isValidScreen(screenIndex) ? m_screens[screenIndex].res : QSizeF(0.0, 0.0);
+}
+
+bool ScreenLayout::isManualRes(int screenIndex) const {
+    return isValidScreen(screenIndex);
+}
+
+bool ScreenLayout::isCalibrationRequired() const {
+    return false;
+}
+
+bool ScreenLayout::isPrimary(int screenIndex) const {
+    return screenIndex == 0 && isValidScreen(screenIndex);
+}
+
+QString ScreenLayout::getScreenName(int screenIndex) const {
+    return isValidScreen(screenIndex) ? m_screens[screenIndex].name : QString();
+}
+
+QSize ScreenLayout::getCursorSize(int) const {
+    return k_cursorSize;
+}
+
+bool ScreenLayout::sizeChanged() const {
+    return false;
+}
+
+QPoint ScreenLayout::constrainPosition(const QPoint& point) const {
+    return Geometry::constrain(m_screenRects, point);
+}
+
+QImage ScreenLayout::grabScreen(int, int, int, int) const {
+    return {};
+}
+
+bool ScreenLayout::isGrabThreadSafe() const {
+    return true;
+}
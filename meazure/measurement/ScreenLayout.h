@@ -0,0 +1,118 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <meazure/environment/ScreenInfoProvider.h>
+#include <meazure/utils/Geometry.h>
+#include <QRect>
+#include <QSize>
+#include <QSizeF>
+#include <QString>
+#include <vector>
+
+
+/// Screen information for a layout of display screens described by the caller rather than obtained from the window
+/// system. A layout allows measurements to be made without a display (e.g. to evaluate positions offline or in unit
+/// tests). The screen resolutions are treated as manually calibrated, and the screen contents are never available.
+///
+class ScreenLayout : public ScreenInfoProvider {
+
+public:
+    static constexpr QSize k_cursorSize { 24, 24 };    ///< Same as the minimum cursor size of a window system screen
+
+    /// Description of a screen in the layout.
+    ///
+    struct Screen {
+        QRect rect;         ///< Position and size of the screen in the virtual screen, in pixels
+        QSizeF res;         ///< Screen resolution, in pixels per inch
+        QString name;       ///< Displayable name for the screen
+    };
+
+    /// Constructs the layout of the specified screens.
+    ///
+    /// @param[in] screens Screens in the layout. The first screen is the primary screen. If screens overlap, a
+    ///     position in the overlap is considered to be on the first of the overlapping screens.
+    ///
+    explicit ScreenLayout(std::vector<Screen> screens);
+
+    ScreenLayout(const ScreenLayout&) = delete;
+    ScreenLayout(ScreenLayout&&) = delete;
+    ScreenLayout& operator=(const ScreenLayout&) = delete;
+
+    [[nodiscard]] int getNumScreens() const override;
+
+    [[nodiscard]] int screenForPoint(const QPoint& point) const override;
+
+    [[nodiscard]] int screenForRect(const QRect& rect) const override;
+
+    /// A layout has no windows, so a window is never on any of its screens.
+    ///
+    /// @return Always -1.
+    ///
+    [[nodiscard]] int screenForWindow(const QWidget* wnd) const override;
+
+    /// A layout has no main window, so the center of the primary screen is returned.
+    ///
+    /// @return Center point of the primary screen.
+    ///
+    [[nodiscard]] QPoint getCenter() const override;
+
+    [[nodiscard]] QRect getVirtualRect() const override;
+
+    [[nodiscard]] QRect getAvailableVirtualRect() const override;
+
+    [[nodiscard]] QRect getScreenRect(int screenIndex) const override;
+
+    [[nodiscard]] QSizeF getPlatformScale(int screenIndex) const override;
+
+    void getScreenRes(int screenIndex, bool& useManualRes, QSizeF& manualRes) const override;
+
+    [[nodiscard]] QSizeF getScreenRes(int screenIndex) const override;
+
+    [[nodiscard]] bool isManualRes(int screenIndex) const override;
+
+    [[nodiscard]] bool isCalibrationRequired() const override;
+
+    [[nodiscard]] bool isPrimary(int screenIndex) const override;
+
+    [[nodiscard]] QString getScreenName(int screenIndex) const override;
+
+    [[nodiscard]] QSize getCursorSize(int screenIndex) const override;
+
+    [[nodiscard]] bool sizeChanged() const override;
+
+    [[nodiscard]] QPoint constrainPosition(const QPoint& point) const override;
+
+    /// The contents of a layout's screens are not available.
+    ///
+    /// @return Always a null image.
+    ///
+    [[nodiscard]] QImage grabScreen(int x, int y, int width, int height) const override;
+
+    [[nodiscard]] bool isGrabThreadSafe() const override;
+
+private:
+    [[nodiscard]] bool isValidScreen(int screenIndex) const {
+        return (screenIndex >= 0 && screenIndex < static_cast<int>(m_screens.size()));
+    }
+
+    std::vector<Screen> m_screens;
+    std::vector<const QRect*> m_screenRects;    ///< Rectangle of each screen, for the Geometry functions
+    Geometry::RectIndex m_screenIndex;          ///< Used to find the screen containing a point or rectangle
+    QRect m_virtualRect;                        ///< Rectangle containing all screens
+};
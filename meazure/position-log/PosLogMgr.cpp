@@ -44,27 +44,31 @@ PosLogMgr::PosLogMgr(const ScreenInfoProvider* screenInfo, UnitsMgr* unitsMgr, T
         m_initialDir(QDir::homePath()) {
     m_title = QString("%1 Position Log File").arg(QGuiApplication::applicationDisplayName());
 
-    connect(m_toolMgr, &ToolMgr::xy1PositionChanged, this, [this](const QPointF& coord) {
-        m_currentToolData.setPoint1(coord);
-    });
-    connect(m_toolMgr, &ToolMgr::xy2PositionChanged, this, [this](const QPointF& coord) {
-        m_currentToolData.setPoint2(coord);
-    });
-    connect(m_toolMgr, &ToolMgr::xyvPositionChanged, this, [this](const QPointF& coord) {
-        m_currentToolData.setPointV(coord);
-    });
-    connect(m_toolMgr, &ToolMgr::widthHeightChanged, this, [this](const QSizeF& widthHeight) {
-        m_currentToolData.setWidthHeight(widthHeight);
-    });
-    connect(m_toolMgr, &ToolMgr::distanceChanged, this, [this](double distance) {
-        m_currentToolData.setDistance(distance);
-    });
-    connect(m_toolMgr, &ToolMgr::angleChanged, this, [this](double angle) {
-        m_currentToolData.setAngle(angle);
-    });
-    connect(m_toolMgr, &ToolMgr::areaChanged, this, [this](double area) {
-        m_currentToolData.setArea(area);
-    });
+    connect(m_toolMgr, &ToolMgr::measurementChanged, this, &PosLogMgr::measurementChanged);
+}
+
+void PosLogMgr::measurementChanged(const MeasurementSnapshot& snapshot) {
+    if (snapshot.hasChanged(XY1Changed)) {
+        m_currentToolData.setPoint1(snapshot.coord1);
+    }
+    if (snapshot.hasChanged(XY2Changed)) {
+        m_currentToolData.setPoint2(snapshot.coord2);
+    }
+    if (snapshot.hasChanged(XYVChanged)) {
+        m_currentToolData.setPointV(snapshot.coordV);
+    }
+    if (snapshot.hasChanged(WHChanged)) {
+        m_currentToolData.setWidthHeight(snapshot.widthHeight);
+    }
+    if (snapshot.hasChanged(DistChanged)) {
+        m_currentToolData.setDistance(snapshot.distance);
+    }
+    if (snapshot.hasChanged(AngleChanged)) {
+        m_currentToolData.setAngle(snapshot.angle);
+    }
+    if (snapshot.hasChanged(AreaChanged)) {
+        m_currentToolData.setArea(snapshot.area);
+    }
 }
 
 void PosLogMgr::changeTitle(const QString& title) {
@@ -82,6 +86,9 @@ void PosLogMgr::addPosition() {
 }
 
 void PosLogMgr::insertPosition(unsigned int positionIndex) {
+    // Measurements are paced to the display refresh, so ensure the latest ones have been received.
+    m_toolMgr->flushMeasurements();
+
     PosLogPosition position;
     position.setToolName(m_toolMgr->getCurentRadioTool()->getName());
     position.setToolTraits(m_toolMgr->getCurentRadioTool()->getTraits());
@@ -21,6 +21,7 @@
 #include "model/PosLogPosition.h"
 #include "model/PosLogDesktop.h"
 #include <meazure/tools/ToolMgr.h>
+#include <meazure/measurement/MeasurementSnapshot.h>
 #include <meazure/environment/ScreenInfoProvider.h>
 #include <meazure/units/UnitsMgr.h>
 #include <meazure/config/Config.h>
@@ -113,6 +114,9 @@ public slots:
 
     void showPosition(unsigned int positionIndex);
 
+private slots:
+    void measurementChanged(const MeasurementSnapshot& snapshot);
+
 private:
     static constexpr int k_archiveMajorVersion { 1 };
     static constexpr const char* k_fileFilter { "Meazure Position Log Files (*.mpl);;All Files (*.*)" };
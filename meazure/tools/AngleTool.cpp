@@ -18,6 +18,7 @@
 #include "AngleTool.h"
 #include <meazure/utils/Geometry.h>
 #include <meazure/utils/StringUtils.h>
+#include <meazure/measurement/Measure.h>
 #include <QPointF>
 #include <QtMath>
 #include <cmath>
@@ -432,36 +433,41 @@ void AngleTool::dragged(Crosshair&, int id, QPoint center, Qt::KeyboardModifiers
 }
 
 void AngleTool::moved(Crosshair&, int id, QPoint) {
+    scheduleMeasurement(id);
+}
+
+void AngleTool::measure(int id) {
     if (!isEnabled()) {
         return;
     }
 
-    const QPointF coord1 = m_unitsProvider->convertCoord(m_point1);
-    const QPointF coord2 = m_unitsProvider->convertCoord(m_point2);
-    const QPointF coordV = m_unitsProvider->convertCoord(m_vertex);
-    const double angle = m_unitsProvider->convertAngle(Geometry::angle(coordV, coord1, coord2));
+    const Measure::Angle angle = Measure::measureAngle(*m_unitsProvider, *m_unitsProvider, m_vertex, m_point1,
+                                                       m_point2);
+
+    m_dataWin1->angleChanged(angle.angle);
+    m_dataWin2->angleChanged(angle.angle);
+    m_dataWinV->angleChanged(angle.angle);
 
-    m_dataWin1->angleChanged(angle);
-    m_dataWin2->angleChanged(angle);
-    m_dataWinV->angleChanged(angle);
+    MeasurementSnapshot snapshot;
     if (id == k_point1Id) {
-        m_dataWin1->xy1PositionChanged(coord1, m_point1);
+        m_dataWin1->xy1PositionChanged(angle.coord1, m_point1);
         m_dataWin1->moveNear(m_point1CH->geometry());
 
-        emit xy1PositionChanged(coord1, m_point1);
+        snapshot.setXY1Position(angle.coord1, m_point1);
     } else if (id == k_point2Id){
-        m_dataWin2->xy2PositionChanged(coord2, m_point2);
+        m_dataWin2->xy2PositionChanged(angle.coord2, m_point2);
         m_dataWin2->moveNear(m_point2CH->geometry());
 
-        emit xy2PositionChanged(coord2, m_point2);
+        snapshot.setXY2Position(angle.coord2, m_point2);
     } else {
-        m_dataWinV->xyvPositionChanged(coordV, m_vertex);
+        m_dataWinV->xyvPositionChanged(angle.coordV, m_vertex);
         m_dataWinV->moveNear(m_vertexCH->geometry());
 
-        emit xyvPositionChanged(coordV, m_vertex);
+        snapshot.setXYVPosition(angle.coordV, m_vertex);
     }
+    snapshot.setAngle(angle.angle);
 
-    emit angleChanged(angle);
+    emit measurementChanged(snapshot);
 
     emitActivePosition();
 }
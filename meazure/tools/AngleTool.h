@@ -92,12 +92,8 @@ public:
     void stepXVPosition(int numSteps) override;
     void stepYVPosition(int numSteps) override;
 
-signals:
-    void activePositionChanged(QPoint rawPos);
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
-    void xy2PositionChanged(QPointF coord, QPoint rawPos);
-    void xyvPositionChanged(QPointF coord, QPoint rawPos);
-    void angleChanged(double angle);
+protected:
+    void measure(int pointId) override;
 
 private slots:
     void entered(Crosshair& crosshair, int id, QPoint center, Qt::KeyboardModifiers keyboardModifiers);
@@ -19,8 +19,8 @@
 #include <meazure/utils/Geometry.h>
 #include <meazure/utils/StringUtils.h>
 #include <meazure/utils/Cloaker.h>
+#include <meazure/measurement/Measure.h>
 #include <QPointF>
-#include <QSizeF>
 
 CircleTool::CircleTool(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, QObject* parent) :
         RadioTool(screenInfo, unitsProvider, parent),
@@ -97,7 +97,8 @@ void CircleTool::setDataWinEnabled(bool enable) {
 }
 
 QImage CircleTool::grabRegion() const {
-    const Cloaker cloak(m_centerCH, m_perimeterCH, m_circle, m_line, m_dataWinCenter, m_dataWinPerimeter);
+    const Cloaker cloak(getDamageTracker(), m_centerCH, m_perimeterCH, m_circle, m_line, m_dataWinCenter,
+                        m_dataWinPerimeter);
 
     const QRect regionRect = m_circle->geometry().normalized();
     return m_screenInfo->grabScreen(regionRect.x(), regionRect.y(), regionRect.width(), regionRect.height());
@@ -283,40 +284,36 @@ void CircleTool::dragged(Crosshair&, int id, QPoint crosshairCenter, Qt::Keyboar
 }
 
 void CircleTool::moved(Crosshair&, int id, QPoint) {
+    scheduleMeasurement(id);
+}
+
+void CircleTool::measure(int id) {
     if (!isEnabled()) {
         return;
     }
 
-    const QPointF coordPerimeter = m_unitsProvider->convertCoord(m_perimeter);
-    const QPointF coordCenter = m_unitsProvider->convertCoord(m_center);
-    const double radius = Geometry::hypot(coordPerimeter, coordCenter);
-    const double diameter = 2.0 * radius;
-    const QSizeF wh = QSizeF(diameter, diameter);
-    const double aspect = Geometry::aspectRatio(wh);
-    const double area = Geometry::area(radius);
-    const double angle = m_unitsProvider->convertAngle(Geometry::angle(coordCenter, coordPerimeter));
-
-    m_dataWinPerimeter->distanceChanged(radius);
-    m_dataWinCenter->distanceChanged(radius);
+    const Measure::Circle circle = Measure::measureCircle(*m_unitsProvider, *m_unitsProvider, m_center, m_perimeter);
+
+    m_dataWinPerimeter->distanceChanged(circle.radius);
+    m_dataWinCenter->distanceChanged(circle.radius);
+
+    MeasurementSnapshot snapshot;
     if (id == k_perimeterId) {
-        m_dataWinPerimeter->xy1PositionChanged(coordPerimeter, m_perimeter);
+        m_dataWinPerimeter->xy1PositionChanged(circle.coordPerimeter, m_perimeter);
         m_dataWinPerimeter->moveNear(m_perimeterCH->geometry());
 
-        emit xy1PositionChanged(coordPerimeter, m_perimeter);
+        snapshot.setXY1Position(circle.coordPerimeter, m_perimeter);
     } else {
-        m_dataWinCenter->xyvPositionChanged(coordCenter, m_center);
+        m_dataWinCenter->xyvPositionChanged(circle.coordCenter, m_center);
         m_dataWinCenter->moveNear(m_centerCH->geometry());
 
-        emit xyvPositionChanged(coordCenter, m_center);
+        snapshot.setXYVPosition(circle.coordCenter, m_center);
     }
+    snapshot.setExtent(circle.widthHeight, circle.radius, circle.angle, circle.area, circle.aspect);
 
     emitActivePosition();
 
-    emit widthHeightChanged(wh);
-    emit distanceChanged(radius);
-    emit areaChanged(area);
-    emit aspectChanged(aspect);
-    emit angleChanged(angle);
+    emit measurementChanged(snapshot);
 }
 
 void CircleTool::emitActivePosition() {
@@ -89,15 +89,8 @@ public:
     void stepXVPosition(int numSteps) override;
     void stepYVPosition(int numSteps) override;
 
-signals:
-    void activePositionChanged(QPoint rawPos);
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
-    void xyvPositionChanged(QPointF coord, QPoint rawPos);
-    void widthHeightChanged(QSizeF widthHeight);
-    void distanceChanged(double distance);
-    void angleChanged(double angle);
-    void aspectChanged(double aspect);
-    void areaChanged(double area);
+protected:
+    void measure(int pointId) override;
 
 private slots:
     void entered(Crosshair& crosshair, int id, QPoint crosshairCenter, Qt::KeyboardModifiers keyboardModifiers);
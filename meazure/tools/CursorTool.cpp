@@ -82,7 +82,10 @@ void CursorTool::emitMeasurement(QPoint position) {
         m_dataWindow->xy1PositionChanged(coord, position);
         placeDataWin(position);
 
+        MeasurementSnapshot snapshot;
+        snapshot.setXY1Position(coord, position);
+
         emit activePositionChanged(position);
-        emit xy1PositionChanged(coord, position);
+        emit measurementChanged(snapshot);
     }
 }
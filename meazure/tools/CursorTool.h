@@ -66,10 +66,6 @@ public:
 
     [[nodiscard]] bool hasCrosshairs() const override;
 
-signals:
-    void activePositionChanged(QPoint rawPos);
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
-
 private slots:
     void cursorMotion(QPoint pos);
 
@@ -19,8 +19,8 @@
 #include <meazure/utils/Geometry.h>
 #include <meazure/utils/StringUtils.h>
 #include <meazure/utils/Cloaker.h>
+#include <meazure/measurement/Measure.h>
 #include <QPointF>
-#include <QSizeF>
 
 LineTool::LineTool(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, QObject* parent) :
         RadioTool(screenInfo, unitsProvider, parent),
@@ -91,7 +91,7 @@ void LineTool::setDataWinEnabled(bool enable) {
 }
 
 QImage LineTool::grabRegion() const {
-    const Cloaker cloak(m_point1CH, m_point2CH, m_line, m_dataWin1, m_dataWin2);
+    const Cloaker cloak(getDamageTracker(), m_point1CH, m_point2CH, m_line, m_dataWin1, m_dataWin2);
 
     const QRect regionRect = QRect(m_point1, m_point2).normalized();
     return m_screenInfo->grabScreen(regionRect.x(), regionRect.y(), regionRect.width(), regionRect.height());
@@ -276,39 +276,36 @@ void LineTool::dragged(Crosshair&, int id, QPoint crosshairCenter, Qt::KeyboardM
 }
 
 void LineTool::moved(Crosshair&, int id, QPoint) {
+    scheduleMeasurement(id);
+}
+
+void LineTool::measure(int id) {
     if (!isEnabled()) {
         return;
     }
 
-    const QPointF coord1 = m_unitsProvider->convertCoord(m_point1);
-    const QPointF coord2 = m_unitsProvider->convertCoord(m_point2);
-    const QSizeF wh = m_unitsProvider->getWidthHeight(m_point1, m_point2);
-    const double distance = Geometry::hypot(wh);
-    const double aspect = Geometry::aspectRatio(wh);
-    const double area = Geometry::area(wh);
-    const double angle = m_unitsProvider->convertAngle(Geometry::angle(coord1, coord2));
+    const Measure::Extent extent = Measure::measureExtent(*m_unitsProvider, *m_unitsProvider, m_point1, m_point2);
+
+    m_dataWin1->distanceChanged(extent.distance);
+    m_dataWin2->distanceChanged(extent.distance);
 
-    m_dataWin1->distanceChanged(distance);
-    m_dataWin2->distanceChanged(distance);
+    MeasurementSnapshot snapshot;
     if (id == k_point1Id) {
-        m_dataWin1->xy1PositionChanged(coord1, m_point1);
+        m_dataWin1->xy1PositionChanged(extent.coord1, m_point1);
         m_dataWin1->moveNear(m_point1CH->geometry());
 
-        emit xy1PositionChanged(coord1, m_point1);
+        snapshot.setXY1Position(extent.coord1, m_point1);
     } else {
-        m_dataWin2->xy2PositionChanged(coord2, m_point2);
+        m_dataWin2->xy2PositionChanged(extent.coord2, m_point2);
         m_dataWin2->moveNear(m_point2CH->geometry());
 
-        emit xy2PositionChanged(coord2, m_point2);
+        snapshot.setXY2Position(extent.coord2, m_point2);
     }
+    snapshot.setExtent(extent.widthHeight, extent.distance, extent.angle, extent.area, extent.aspect);
 
     emitActivePosition();
 
-    emit widthHeightChanged(wh);
-    emit distanceChanged(distance);
-    emit areaChanged(area);
-    emit aspectChanged(aspect);
-    emit angleChanged(angle);
+    emit measurementChanged(snapshot);
 }
 
 void LineTool::emitActivePosition() {
@@ -88,15 +88,8 @@ public:
     void stepX2Position(int numSteps) override;
     void stepY2Position(int numSteps) override;
 
-signals:
-    void activePositionChanged(QPoint rawPos);
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
-    void xy2PositionChanged(QPointF coord, QPoint rawPos);
-    void widthHeightChanged(QSizeF widthHeight);
-    void distanceChanged(double distance);
-    void angleChanged(double angle);
-    void aspectChanged(double aspect);
-    void areaChanged(double area);
+protected:
+    void measure(int pointId) override;
 
 private slots:
     void entered(Crosshair& crosshair, int id, QPoint crosshairCenter, Qt::KeyboardModifiers keyboardModifiers);
@@ -162,14 +162,21 @@ void PointTool::dragged(Crosshair&, int, QPoint center, Qt::KeyboardModifiers ke
     setPosition();
 }
 
-void PointTool::moved(Crosshair&, int, QPoint center) {
+void PointTool::moved(Crosshair&, int id, QPoint) {
+    scheduleMeasurement(id);
+}
+
+void PointTool::measure(int) {
     if (isEnabled()) {
-        const QPointF coord = m_unitsProvider->convertCoord(center);
+        const QPointF coord = m_unitsProvider->convertCoord(m_center);
 
-        m_dataWindow->xy1PositionChanged(coord, center);
+        m_dataWindow->xy1PositionChanged(coord, m_center);
         m_dataWindow->moveNear(m_crosshair->geometry());
 
-        emit activePositionChanged(center);
-        emit xy1PositionChanged(coord, center);
+        MeasurementSnapshot snapshot;
+        snapshot.setXY1Position(coord, m_center);
+
+        emit activePositionChanged(m_center);
+        emit measurementChanged(snapshot);
     }
 }
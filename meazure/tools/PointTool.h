@@ -79,9 +79,8 @@ public:
     void stepX1Position(int numSteps) override;
     void stepY1Position(int numSteps) override;
 
-signals:
-    void activePositionChanged(QPoint rawPos);
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
+protected:
+    void measure(int pointId) override;
 
 private slots:
     void entered(Crosshair& crosshair, int id, QPoint center, Qt::KeyboardModifiers keyboardModifiers);
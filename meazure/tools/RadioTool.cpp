@@ -16,10 +16,15 @@
  */
 
 #include "RadioTool.h"
+#include <meazure/environment/x11/X11ScreenDamageTracker.h>
+#include <meazure/environment/noop/NoopScreenDamageTracker.h>
+#include <meazure/utils/PlatformUtils.h>
+#include <algorithm>
 
 
 RadioTool::RadioTool(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, QObject *parent) :
         Tool(screenInfo, unitsProvider, parent) {
+    connect(&m_measurePacer, &RefreshPacer::triggered, this, &RadioTool::flushMeasurements);
 }
 
 void RadioTool::setCrosshairsEnabled(bool) {
@@ -79,3 +84,43 @@ void RadioTool::stepXVPosition(int) {
 
 void RadioTool::stepYVPosition(int) {
 }
+
+void RadioTool::flushMeasurements() {
+    if (m_pendingMeasurements.empty()) {
+        m_measurePacer.stop();
+        return;
+    }
+
+    m_measurePacer.markPerformed();
+
+    // Measuring can move the tool and so schedule another measurement, so measure from a copy of the list.
+    std::vector<int> pending;
+    pending.swap(m_pendingMeasurements);
+    for (const int pointId : pending) {
+        measure(pointId);
+    }
+}
+
+void RadioTool::scheduleMeasurement(int pointId) {
+    if (std::find(m_pendingMeasurements.begin(), m_pendingMeasurements.end(), pointId) ==
+            m_pendingMeasurements.end()) {
+        m_pendingMeasurements.push_back(pointId);
+    }
+
+    m_measurePacer.schedule();
+}
+
+void RadioTool::measure(int) {
+}
+
+ScreenDamageTracker* RadioTool::getDamageTracker() const {
+    if (!m_damageTracker) {
+        if (PlatformUtils::isX11()) {
+            m_damageTracker = std::make_unique<X11ScreenDamageTracker>();
+        } else {
+            m_damageTracker = std::make_unique<NoopScreenDamageTracker>();
+        }
+    }
+
+    return m_damageTracker.get();
+}
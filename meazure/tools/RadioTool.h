@@ -19,12 +19,17 @@
 
 #include "Tool.h"
 #include "RadioToolTraits.h"
+#include <meazure/measurement/MeasurementSnapshot.h>
 #include <meazure/units/UnitsProvider.h>
 #include <meazure/environment/ScreenInfo.h>
+#include <meazure/environment/ScreenDamageTracker.h>
 #include <meazure/graphics/Crosshair.h>
+#include <meazure/utils/RefreshPacer.h>
 #include <QObject>
 #include <QImage>
 #include <QPointF>
+#include <vector>
+#include <memory>
 
 
 class RadioTool : public Tool {
@@ -184,6 +189,26 @@ public:
     ///
     virtual void stepYVPosition(int numSteps);
 
+    /// Immediately makes any measurements that have been scheduled by the tool but not yet made. Call this method
+    /// when the measurements must reflect the current position of the tool (e.g. after stepping a position from the
+    /// keyboard or before recording a position).
+    ///
+    void flushMeasurements();
+
+signals:
+    /// Emitted when the position of the tool's active point (e.g. the crosshair being dragged) changes.
+    ///
+    /// @param[in] rawPos Screen position of the active point, in pixels
+    ///
+    void activePositionChanged(QPoint rawPos);
+
+    /// Emitted once for each step of a measurement (e.g. each movement of a crosshair) with all the measurements
+    /// that changed in that step.
+    ///
+    /// @param[in] snapshot Measurements made by the tool. Only the measurements flagged as changed are valid.
+    ///
+    void measurementChanged(const MeasurementSnapshot& snapshot);
+
 protected:
     /// Offset, in inches, from the a given point so that there will be a margin around crosshairs.
     /// When drawing lines to crosshairs, this offset will ensure that there is a bit of a margin
@@ -196,4 +221,32 @@ protected:
     /// around the crosshair such that the line will come close to but not touch the crosshair.
     ///
     static constexpr double k_disabledCrosshairOffset { 0.07 };
+
+    /// Schedules the measurements for the specified point of the tool. While a tool is dragged, its points can move
+    /// many times between display refreshes. Rather than converting and displaying the measurements for each movement,
+    /// the measurements are made at most once per display refresh, using the latest positions. A movement following
+    /// a pause is measured as soon as control returns to the event loop.
+    ///
+    /// @param[in] pointId Identifies the point that has moved (e.g. crosshair ID)
+    ///
+    void scheduleMeasurement(int pointId);
+
+    /// Called to make the measurements for the specified point of the tool and emit the measurementChanged signal.
+    /// The base class implementation does nothing.
+    ///
+    /// @param[in] pointId Identifies the point that has moved, as passed to scheduleMeasurement
+    ///
+    virtual void measure(int pointId);
+
+    /// Obtains the screen damage tracker used to wait for the tool graphics to be removed from the screen before
+    /// grabbing a region (see Cloaker). The tracker is created when first requested and reused thereafter.
+    ///
+    /// @return Screen damage tracker for the tool.
+    ///
+    [[nodiscard]] ScreenDamageTracker* getDamageTracker() const;
+
+private:
+    RefreshPacer m_measurePacer;            ///< Paces the measurements to the display refresh
+    std::vector<int> m_pendingMeasurements; ///< IDs of the points to measure, in the order they moved
+    mutable std::unique_ptr<ScreenDamageTracker> m_damageTracker;
 };
@@ -203,8 +203,8 @@ QRect RulerTool::constructBoundingRect() {
 void RulerTool::refresh() {
     setPosition();
 
-    m_hRuler->repaint();
-    m_vRuler->repaint();
+    m_hRuler->refresh();
+    m_vRuler->refresh();
 }
 
 void RulerTool::radioToolSelected(RadioTool&) {
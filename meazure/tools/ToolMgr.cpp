@@ -27,6 +27,7 @@
 #include "RectangleTool.h"
 #include "WindowTool.h"
 #include "RulerTool.h"
+#include <initializer_list>
 
 
 ToolMgr::ToolMgr(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider) {
@@ -57,76 +58,28 @@ ToolMgr::ToolMgr(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvide
     m_tools[gridTool->getName()] = gridTool;
     m_tools[originTool->getName()] = originTool;
 
-    connect(cursorTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(cursorTool, SIGNAL(activePositionChanged(QPoint)), this, SIGNAL(activePositionChanged(QPoint)));
-    connect(cursorTool, SIGNAL(xy1PositionChanged(QPointF, QPoint)), this, SIGNAL(xy1PositionChanged(QPointF, QPoint)));
-
-    connect(pointTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(pointTool, SIGNAL(activePositionChanged(QPoint)), this, SIGNAL(activePositionChanged(QPoint)));
-    connect(pointTool, SIGNAL(xy1PositionChanged(QPointF, QPoint)), this, SIGNAL(xy1PositionChanged(QPointF, QPoint)));
-
-    connect(lineTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(lineTool, SIGNAL(activePositionChanged(QPoint)), this, SIGNAL(activePositionChanged(QPoint)));
-    connect(lineTool, SIGNAL(xy1PositionChanged(QPointF, QPoint)), this, SIGNAL(xy1PositionChanged(QPointF, QPoint)));
-    connect(lineTool, SIGNAL(xy2PositionChanged(QPointF, QPoint)), this, SIGNAL(xy2PositionChanged(QPointF, QPoint)));
-    connect(lineTool, SIGNAL(widthHeightChanged(QSizeF)), this, SIGNAL(widthHeightChanged(QSizeF)));
-    connect(lineTool, SIGNAL(distanceChanged(double)), this, SIGNAL(distanceChanged(double)));
-    connect(lineTool, SIGNAL(angleChanged(double)), this, SIGNAL(angleChanged(double)));
-    connect(lineTool, SIGNAL(areaChanged(double)), this, SIGNAL(areaChanged(double)));
-    connect(lineTool, SIGNAL(aspectChanged(double)), this, SIGNAL(aspectChanged(double)));
-
-    connect(rectangleTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(rectangleTool, SIGNAL(activePositionChanged(QPoint)), this, SIGNAL(activePositionChanged(QPoint)));
-    connect(rectangleTool, SIGNAL(xy1PositionChanged(QPointF, QPoint)), this, SIGNAL(xy1PositionChanged(QPointF, QPoint)));
-    connect(rectangleTool, SIGNAL(xy2PositionChanged(QPointF, QPoint)), this, SIGNAL(xy2PositionChanged(QPointF, QPoint)));
-    connect(rectangleTool, SIGNAL(widthHeightChanged(QSizeF)), this, SIGNAL(widthHeightChanged(QSizeF)));
-    connect(rectangleTool, SIGNAL(distanceChanged(double)), this, SIGNAL(distanceChanged(double)));
-    connect(rectangleTool, SIGNAL(angleChanged(double)), this, SIGNAL(angleChanged(double)));
-    connect(rectangleTool, SIGNAL(areaChanged(double)), this, SIGNAL(areaChanged(double)));
-    connect(rectangleTool, SIGNAL(aspectChanged(double)), this, SIGNAL(aspectChanged(double)));
-
-    connect(circleTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(circleTool, SIGNAL(activePositionChanged(QPoint)), this, SIGNAL(activePositionChanged(QPoint)));
-    connect(circleTool, SIGNAL(xy1PositionChanged(QPointF, QPoint)), this, SIGNAL(xy1PositionChanged(QPointF, QPoint)));
-    connect(circleTool, SIGNAL(xyvPositionChanged(QPointF, QPoint)), this, SIGNAL(xyvPositionChanged(QPointF, QPoint)));
-    connect(circleTool, SIGNAL(widthHeightChanged(QSizeF)), this, SIGNAL(widthHeightChanged(QSizeF)));
-    connect(circleTool, SIGNAL(distanceChanged(double)), this, SIGNAL(distanceChanged(double)));
-    connect(circleTool, SIGNAL(angleChanged(double)), this, SIGNAL(angleChanged(double)));
-    connect(circleTool, SIGNAL(areaChanged(double)), this, SIGNAL(areaChanged(double)));
-    connect(circleTool, SIGNAL(aspectChanged(double)), this, SIGNAL(aspectChanged(double)));
-
-    connect(angleTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(angleTool, SIGNAL(activePositionChanged(QPoint)), this, SIGNAL(activePositionChanged(QPoint)));
-    connect(angleTool, SIGNAL(xy1PositionChanged(QPointF, QPoint)), this, SIGNAL(xy1PositionChanged(QPointF, QPoint)));
-    connect(angleTool, SIGNAL(xy2PositionChanged(QPointF, QPoint)), this, SIGNAL(xy2PositionChanged(QPointF, QPoint)));
-    connect(angleTool, SIGNAL(xyvPositionChanged(QPointF, QPoint)), this, SIGNAL(xyvPositionChanged(QPointF, QPoint)));
-    connect(angleTool, SIGNAL(angleChanged(double)), this, SIGNAL(angleChanged(double)));
-
-    connect(windowTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(windowTool, SIGNAL(activePositionChanged(QPoint)), this, SIGNAL(activePositionChanged(QPoint)));
-    connect(windowTool, SIGNAL(xy1PositionChanged(QPointF, QPoint)), this, SIGNAL(xy1PositionChanged(QPointF, QPoint)));
-    connect(windowTool, SIGNAL(xy2PositionChanged(QPointF, QPoint)), this, SIGNAL(xy2PositionChanged(QPointF, QPoint)));
-    connect(windowTool, SIGNAL(widthHeightChanged(QSizeF)), this, SIGNAL(widthHeightChanged(QSizeF)));
-    connect(windowTool, SIGNAL(distanceChanged(double)), this, SIGNAL(distanceChanged(double)));
-    connect(windowTool, SIGNAL(angleChanged(double)), this, SIGNAL(angleChanged(double)));
-    connect(windowTool, SIGNAL(areaChanged(double)), this, SIGNAL(areaChanged(double)));
-    connect(windowTool, SIGNAL(aspectChanged(double)), this, SIGNAL(aspectChanged(double)));
-
-    connect(rulerTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
-    connect(this, &ToolMgr::radioToolSelected, rulerTool, &RulerTool::radioToolSelected);
-    connect(this, &ToolMgr::xy1PositionChanged, this, [rulerTool](QPointF, QPoint rawPos) {
-        rulerTool->setIndicator(0, rawPos);
-    });
-    connect(this, &ToolMgr::xy2PositionChanged, this, [rulerTool](QPointF, QPoint rawPos) {
-        rulerTool->setIndicator(1, rawPos);
-    });
-    connect(this, &ToolMgr::xyvPositionChanged, this, [rulerTool](QPointF, QPoint rawPos) {
-        rulerTool->setIndicator(2, rawPos);
-    });
+    for (RadioTool* radioTool : std::initializer_list<RadioTool*>{ cursorTool, pointTool, lineTool, rectangleTool,
+                                                                    circleTool, angleTool, windowTool }) {
+        connect(radioTool, &RadioTool::activePositionChanged, this, &ToolMgr::activePositionChanged);
+        connect(radioTool, &RadioTool::measurementChanged, this, &ToolMgr::measurementChanged);
+    }
 
-    connect(gridTool, SIGNAL(toolEnabled(Tool&, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
+    for (const auto& toolEntry : m_tools) {
+        connect(toolEntry.second, &Tool::toolEnabled, this, &ToolMgr::toolEnabled);
+    }
 
-    connect(originTool, SIGNAL(toolEnabled(Tool &, bool)), this, SIGNAL(toolEnabled(Tool&, bool)));
+    connect(this, &ToolMgr::radioToolSelected, rulerTool, &RulerTool::radioToolSelected);
+    connect(this, &ToolMgr::measurementChanged, this, [rulerTool](const MeasurementSnapshot& snapshot) {
+        if (snapshot.hasChanged(XY1Changed)) {
+            rulerTool->setIndicator(0, snapshot.rawPos1);
+        }
+        if (snapshot.hasChanged(XY2Changed)) {
+            rulerTool->setIndicator(1, snapshot.rawPos2);
+        }
+        if (snapshot.hasChanged(XYVChanged)) {
+            rulerTool->setIndicator(2, snapshot.rawPosV);
+        }
+    });
 
     connect(this, &ToolMgr::activePositionChanged, this, [this](QPoint pos) { m_activePosition = pos; });
 
@@ -256,26 +209,32 @@ void ToolMgr::setYVPosition(double y) {
 
 void ToolMgr::stepX1Position(int numSteps) {
     m_currentRadioTool->stepX1Position(numSteps);
+    m_currentRadioTool->flushMeasurements();
 }
 
 void ToolMgr::stepY1Position(int numSteps) {
     m_currentRadioTool->stepY1Position(numSteps);
+    m_currentRadioTool->flushMeasurements();
 }
 
 void ToolMgr::stepX2Position(int numSteps) {
     m_currentRadioTool->stepX2Position(numSteps);
+    m_currentRadioTool->flushMeasurements();
 }
 
 void ToolMgr::stepY2Position(int numSteps) {
     m_currentRadioTool->stepY2Position(numSteps);
+    m_currentRadioTool->flushMeasurements();
 }
 
 void ToolMgr::stepXVPosition(int numSteps) {
     m_currentRadioTool->stepXVPosition(numSteps);
+    m_currentRadioTool->flushMeasurements();
 }
 
 void ToolMgr::stepYVPosition(int numSteps) {
     m_currentRadioTool->stepYVPosition(numSteps);
+    m_currentRadioTool->flushMeasurements();
 }
 
 void ToolMgr::refresh() {
@@ -19,6 +19,7 @@
 
 #include "Tool.h"
 #include "RadioTool.h"
+#include <meazure/measurement/MeasurementSnapshot.h>
 #include <meazure/environment/ScreenInfo.h>
 #include <meazure/units/UnitsProvider.h>
 #include <meazure/config/Config.h>
@@ -26,7 +27,6 @@
 #include <QString>
 #include <QPointF>
 #include <QPoint>
-#include <QSizeF>
 #include <map>
 
 
@@ -91,6 +91,11 @@ public:
     ///
     void strobeTool() const { m_currentRadioTool->strobe(); }
 
+    /// Immediately makes any measurements that the current radio tool has scheduled but not yet made, so that the
+    /// most recently emitted measurements reflect the current position of the tool.
+    ///
+    void flushMeasurements() const { m_currentRadioTool->flushMeasurements(); }
+
 public slots:
     /// Causes the current tool to remeasure thereby emitting any measurement related signals. Typically, this method
     /// is called when the measurement units are changed or when the tool is first selected. Does nothing if the tool
@@ -225,14 +230,11 @@ signals:
 
     void activePositionChanged(QPoint rawPos);
 
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
-    void xy2PositionChanged(QPointF coord, QPoint rawPos);
-    void xyvPositionChanged(QPointF coord, QPoint rawPos);
-    void widthHeightChanged(QSizeF widthHeight);
-    void distanceChanged(double distance);
-    void angleChanged(double angle);
-    void aspectChanged(double aspect);
-    void areaChanged(double area);
+    /// Emitted once for each step of a measurement made by the current radio tool.
+    ///
+    /// @param[in] snapshot Measurements made by the tool. Only the measurements flagged as changed are valid.
+    ///
+    void measurementChanged(const MeasurementSnapshot& snapshot);
 
 private:
     using ToolsMap = std::map<QString, Tool*>;   ///< Maps a tool name to the tool object.
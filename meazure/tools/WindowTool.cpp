@@ -20,10 +20,10 @@
 #include <meazure/environment/x11/X11WindowTracker.h>
 #include <meazure/environment/noop/NoopWindowFinder.h>
 #include <meazure/environment/noop/NoopWindowTracker.h>
-#include <meazure/utils/Geometry.h>
 #include <meazure/utils/Cloaker.h>
 #include <meazure/utils/PlatformUtils.h>
 #include <meazure/graphics/Dimensions.h>
+#include <meazure/measurement/Measure.h>
 
 WindowTool::WindowTool(const ScreenInfo* screenInfo, const UnitsProvider* unitsProvider, QObject* parent) :
         RadioTool(screenInfo, unitsProvider, parent),
@@ -40,9 +40,8 @@ WindowTool::WindowTool(const ScreenInfo* screenInfo, const UnitsProvider* unitsP
     }
 
     connect(m_pointerTracker, &CursorTracker::motion, this, &WindowTool::cursorMotion);
-    connect(dynamic_cast<const QObject*>(m_windowTracker),
-            SIGNAL(windowChanged(unsigned long, int16_t, int16_t, uint16_t, uint16_t)),
-            this, SLOT(windowChanged(unsigned long, int16_t, int16_t, uint16_t, uint16_t)));
+    connect(dynamic_cast<const QObject*>(m_windowTracker), SIGNAL(windowEvent(WindowEvent)),
+            this, SLOT(windowEvent(WindowEvent)));
 }
 
 WindowTool::~WindowTool() {
@@ -76,7 +75,7 @@ void WindowTool::setDataWinEnabled(bool enable) {
 }
 
 QImage WindowTool::grabRegion() const {
-    const Cloaker cloak(m_rectangle, m_dataWindow);
+    const Cloaker cloak(getDamageTracker(), m_rectangle, m_dataWindow);
 
     const QRect regionRect = m_rectangle->geometry().normalized();
     return m_screenInfo->grabScreen(regionRect.x(), regionRect.y(), regionRect.width(), regionRect.height());
@@ -94,8 +93,8 @@ bool WindowTool::hasCrosshairs() const {
     return false;
 }
 
-void WindowTool::windowChanged(unsigned long, int16_t, int16_t, uint16_t, uint16_t) {
-    m_windowFinder->refresh();
+void WindowTool::windowEvent(const WindowEvent& event) {
+    m_windowFinder->update(event);
 }
 
 void WindowTool::cursorMotion(QPoint pos) {
@@ -121,26 +120,19 @@ void WindowTool::setPosition(const QPoint& position) {
     m_rectangle->setPosition(point1, point2);
     m_rectangle->show();
 
-    const QPointF coord1 = m_unitsProvider->convertCoord(point1);
-    const QPointF coord2 = m_unitsProvider->convertCoord(point2);
-    const QSizeF wh = m_unitsProvider->getWidthHeight(point1, point2);
-    const double distance = Geometry::hypot(wh);
-    const double aspect = Geometry::aspectRatio(wh);
-    const double area = Geometry::area(wh);
-    const double angle = m_unitsProvider->convertAngle(Geometry::angle(coord1, coord2));
+    const Measure::Extent extent = Measure::measureExtent(*m_unitsProvider, *m_unitsProvider, point1, point2);
 
-    m_dataWindow->widthHeightChanged(wh);
+    m_dataWindow->widthHeightChanged(extent.widthHeight);
     m_dataWindow->moveNear(point1);
     if (isDataWinEnabled()) {
         m_dataWindow->show();
     }
 
+    MeasurementSnapshot snapshot;
+    snapshot.setXY1Position(extent.coord1, point1);
+    snapshot.setXY2Position(extent.coord2, point2);
+    snapshot.setExtent(extent.widthHeight, extent.distance, extent.angle, extent.area, extent.aspect);
+
     emit activePositionChanged(point1);
-    emit xy1PositionChanged(coord1, point1);
-    emit xy2PositionChanged(coord2, point2);
-    emit widthHeightChanged(wh);
-    emit distanceChanged(distance);
-    emit areaChanged(area);
-    emit aspectChanged(aspect);
-    emit angleChanged(angle);
+    emit measurementChanged(snapshot);
 }
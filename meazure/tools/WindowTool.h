@@ -66,19 +66,9 @@ public:
 
     [[nodiscard]] bool hasCrosshairs() const override;
 
-signals:
-    void activePositionChanged(QPoint rawPos);
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
-    void xy2PositionChanged(QPointF coord, QPoint rawPos);
-    void widthHeightChanged(QSizeF widthHeight);
-    void distanceChanged(double distance);
-    void angleChanged(double angle);
-    void aspectChanged(double aspect);
-    void areaChanged(double area);
-
 private slots:
     void cursorMotion(QPoint pos);
-    void windowChanged(unsigned long windowId, int16_t x, int16_t y, uint16_t width, uint16_t height);
+    void windowEvent(const WindowEvent& event);
 
 private:
     static constexpr RadioToolTraits k_traits { XY1ReadOnly | XY2ReadOnly | WHReadOnly | DistReadOnly |
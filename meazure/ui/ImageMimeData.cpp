@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ImageMimeData.h"
+#include <QBuffer>
+#include <QIODevice>
+
+
+ImageMimeData::ImageMimeData(const QImage& image) : m_image(image) {
+}
+
+ImageMimeData::~ImageMimeData() {
+    // Encodings still in progress hold their own reference to the image, but must finish before the data goes away.
+    for (auto& encoding : m_encodings) {
+        encoding.second.wait();
+    }
+}
+
+bool ImageMimeData::hasFormat(const QString& mimeType) const {
+    return formats().contains(mimeType);
+}
+
+QStringList ImageMimeData::formats() const {
+    if (m_image.isNull()) {
+        return {};
+    }
+    return { k_pngFormat, k_bmpFormat, k_imageFormat };
+}
+
+void ImageMimeData::prepare(const QString& mimeType) const {
+    const char* format = imageFormat(mimeType);
+    if (format == nullptr || m_image.isNull() || m_encodings.find(mimeType) != m_encodings.end()) {
+        return;
+    }
+
+    m_encodings[mimeType] = std::async(std::launch::async, [image = m_image, format]() {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, format);
+        return data;
+    }).share();
+}
+
+QVariant ImageMimeData::retrieveData(const QString& mimeType, QMetaType type) const {
+    if (m_image.isNull()) {
+        return {};
+    }
+
+    if (mimeType == k_imageFormat) {
+        return m_image;
+    }
+
+    if (imageFormat(mimeType) == nullptr) {
+        return QMimeData::retrieveData(mimeType, type);
+    }
+
+    prepare(mimeType);
+    return m_encodings[mimeType].get();
+}
+
+const char* ImageMimeData::imageFormat(const QString& mimeType) {
+    if (mimeType == k_pngFormat) {
+        return "PNG";
+    }
+    if (mimeType == k_bmpFormat) {
+        return "BMP";
+    }
+    return nullptr;
+}
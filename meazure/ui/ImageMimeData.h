@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QMimeData>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVariant>
+#include <QMetaType>
+#include <map>
+#include <future>
+
+
+/// Clipboard data holding a captured image. Unlike QMimeData::setImageData, which results in the image being
+/// encoded into each image format when it is placed on the clipboard, the image is kept as captured and is only
+/// encoded into a format when that format is requested (e.g. by a paste target). Encoding is performed on a worker
+/// thread and each encoding is cached once it has been produced, so a format requested repeatedly is only encoded
+/// once.
+///
+class ImageMimeData : public QMimeData {
+
+    Q_OBJECT
+
+public:
+    static constexpr const char* k_pngFormat { "image/png" };
+    static constexpr const char* k_bmpFormat { "image/bmp" };
+    static constexpr const char* k_imageFormat { "application/x-qt-image" };
+
+    /// Constructs the clipboard data.
+    ///
+    /// @param[in] image Captured image to place on the clipboard
+    ///
+    explicit ImageMimeData(const QImage& image);
+
+    ~ImageMimeData() override;
+
+    ImageMimeData(const ImageMimeData&) = delete;
+    ImageMimeData(ImageMimeData&&) = delete;
+    ImageMimeData& operator=(const ImageMimeData&) = delete;
+
+    [[nodiscard]] bool hasFormat(const QString& mimeType) const override;
+
+    [[nodiscard]] QStringList formats() const override;
+
+    /// Starts encoding the image into the specified format on the worker thread, without waiting for the encoding
+    /// to complete. Use this to prepare a format that is very likely to be requested, so that it is available
+    /// without delay when it is requested. Nothing is done if the format has already been encoded or is being
+    /// encoded.
+    ///
+    /// @param[in] mimeType Format into which to encode the image (i.e. k_pngFormat or k_bmpFormat)
+    ///
+    void prepare(const QString& mimeType) const;
+
+protected:
+    [[nodiscard]] QVariant retrieveData(const QString& mimeType, QMetaType type) const override;
+
+private:
+    /// Obtains the Qt image format name corresponding to the specified MIME type.
+    ///
+    /// @param[in] mimeType MIME type of the format
+    /// @return Qt image format name, or nullptr if the MIME type is not an encoded format supported by this class.
+    ///
+    static const char* imageFormat(const QString& mimeType);
+
+    QImage m_image;
+    mutable std::map<QString, std::shared_future<QByteArray>> m_encodings;      ///< Keyed by MIME type
+};
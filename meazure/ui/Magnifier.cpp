@@ -16,17 +16,20 @@
  */
 
 #include "Magnifier.h"
+#include <meazure/environment/x11/X11ScreenDamageTracker.h>
+#include <meazure/environment/noop/NoopScreenDamageTracker.h>
+#include <meazure/graphics/PixelZoom.h>
 #include <meazure/utils/MathUtils.h>
+#include <meazure/utils/PlatformUtils.h>
 #include <QPainter>
 #include <QBrush>
 #include <QColor>
+#include <algorithm>
 
 
 Magnifier::Magnifier(const ScreenInfoProvider* screenInfo, const ToolMgr* toolMgr) :
         m_screenInfo(screenInfo),
-        m_darkGridPen(QBrush(QColor(k_darkGridColor)), 1),
-        m_lightGridPen(QBrush(QColor(k_lightGridColor)), 1),
-        m_centerMarkerPen(QBrush(QColor(255, 0, 0)), 1) {
+        m_borderPen(QBrush(QColor(k_darkGridColor)), 1) {
     const int screenIdx = m_screenInfo->screenForWindow(this);
     const QSizeF& platformScale = m_screenInfo->getPlatformScale(screenIdx);
     m_width = MathUtils::makeOddDown(qRound(k_size * platformScale.width()));
@@ -34,29 +37,64 @@ Magnifier::Magnifier(const ScreenInfoProvider* screenInfo, const ToolMgr* toolMg
 
     setFixedSize(m_width, m_height);
 
+    m_zoomedImage = QImage(m_width, m_height, QImage::Format_RGB32);
+
+    // The screen is captured on a worker thread. The largest capture is the entire magnifier area, which is
+    // captured when the magnifier is frozen.
+    m_capture = new MagnifierCapture(m_screenInfo, QSize(m_width, m_height), this);
+    connect(m_capture, &MagnifierCapture::frameReady, this, &Magnifier::frameCaptured);
+    m_capture->start();
+
     setStatusTip(tr("Magnified active position"));
     setWhatsThis(tr("Magnifies the area around the active position"));
 
+    if (PlatformUtils::isX11()) {
+        m_damageTracker = new X11ScreenDamageTracker(this);
+    } else {
+        m_damageTracker = new NoopScreenDamageTracker(this);
+    }
+
+    // When changes to the screen contents can be tracked, the screen is only grabbed when the contents under the
+    // magnifier or the active position change. Otherwise, the screen is grabbed periodically.
+    m_damageDriven = m_damageTracker->isSupported();
+
     m_grabTimer.setTimerType(Qt::PreciseTimer);
     m_grabTimer.setInterval(k_updateRate);
     connect(&m_grabTimer, &QTimer::timeout, this, &Magnifier::periodicGrab);
 
+    // Pace the grabs so that continuous changes (e.g. an animation under the magnifier or a fast moving cursor)
+    // do not cause the magnifier to refresh faster than the maximum refresh rate.
+    m_grabPacer.setRefreshRate(m_maxRefreshRate);
+    connect(&m_grabPacer, &RefreshPacer::triggered, this, &Magnifier::periodicGrab);
+
+    connect(dynamic_cast<const QObject*>(m_damageTracker), SIGNAL(damaged()), this, SLOT(requestGrab()));
     connect(toolMgr, &ToolMgr::activePositionChanged, this, &Magnifier::setCurPos);
 
     setZoom(m_zoomIndex);
     setGridType(m_gridType);
 
-    m_grabTimer.start();
+    startGrabbing();
 }
 
 void Magnifier::writeConfig(Config& config) const {
     config.writeInt("ZoomIndex", m_zoomIndex);
     config.writeInt("MagGridType", m_gridType);
+    config.writeInt("MagMaxRefreshRate", m_maxRefreshRate);
 }
 
 void Magnifier::readConfig(const Config& config) {
     setZoom(config.readInt("ZoomIndex", m_zoomIndex));
     setGridType(static_cast<GridType>(config.readInt("MagGridType", m_gridType)));
+    setMaxRefreshRate(config.readInt("MagMaxRefreshRate", m_maxRefreshRate));
+}
+
+void Magnifier::setMaxRefreshRate(int rate) {
+    m_maxRefreshRate = std::clamp(rate, k_minRefreshRate, k_maxRefreshRate);
+    m_grabPacer.setRefreshRate(m_maxRefreshRate);
+}
+
+qint64 Magnifier::getCaptureLatency() const {
+    return m_capture->currentFrame().latency;
 }
 
 void Magnifier::zoomIn() {
@@ -72,14 +110,18 @@ void Magnifier::setZoom(int zoomIndex) {
         m_zoomIndex = zoomIndex;
 
         const int zoomFactor = k_zoomFactors[zoomIndex];
-        const int originX = m_width * (1 - zoomFactor) / 2;
-        const int originY = m_height * (1 - zoomFactor) / 2;
-        m_zoomTransform = QTransform::fromTranslate(originX, originY).scale(zoomFactor, zoomFactor);
 
         const int markerCoordX = (m_width - zoomFactor) / 2;
         const int markerCoordY = (m_height - zoomFactor) / 2;
         m_centerMarker = QRect(markerCoordX, markerCoordY, zoomFactor, zoomFactor);
 
+        // Only the screen pixels that are visible at the current zoom factor need to be grabbed. The center pixel
+        // is drawn in the center marker and enough pixels are needed on either side of it to cover the remainder
+        // of the magnifier. The size is always odd so that the cursor position is the center pixel.
+        const int halfWidth = (markerCoordX + zoomFactor - 1) / zoomFactor + k_guardBand;
+        const int halfHeight = (markerCoordY + zoomFactor - 1) / zoomFactor + k_guardBand;
+        m_sourceSize = QSize(std::min(2 * halfWidth + 1, m_width), std::min(2 * halfHeight + 1, m_height));
+
         m_gridLines.clear();
         const int coordMaxX = m_width - 1;
         const int coordMaxY = m_height - 1;
@@ -96,6 +138,13 @@ void Magnifier::setZoom(int zoomIndex) {
             m_gridLines.emplace_back(0, y, coordMaxY, y);
         }
 
+        updateWatchRect();
+
+        // A frozen image is left as is. It covers the entire magnifier so it can be viewed at any zoom factor.
+        if (!m_frozen) {
+            m_capture->requestCapture(m_curPos, m_sourceSize);
+        }
+
         repaint();
 
         emit zoomChanged(zoomIndex);
@@ -103,10 +152,15 @@ void Magnifier::setZoom(int zoomIndex) {
 }
 
 void Magnifier::setFreeze(bool frozen) {
+    m_frozen = frozen;
+
     if (frozen) {
-        m_grabTimer.stop();
+        stopGrabbing();
+
+        // Grab the entire magnifier area so that the frozen image can be viewed at any zoom factor.
+        m_capture->requestCapture(m_curPos, QSize(m_width, m_height));
     } else {
-        m_grabTimer.start();
+        startGrabbing();
     }
 
     emit freezeChanged(frozen);
@@ -120,48 +174,83 @@ void Magnifier::setGridType(GridType type) {
 }
 
 void Magnifier::setCurPos(QPoint rawPos) {
-    m_curPos = rawPos;
+    if (rawPos != m_curPos) {
+        m_curPos = rawPos;
+        updateWatchRect();
+        requestGrab();
+    }
+}
+
+void Magnifier::startGrabbing() {
+    if (m_damageDriven) {
+        m_damageTracker->start();
+        requestGrab();
+    } else {
+        m_grabTimer.start();
+    }
+}
+
+void Magnifier::stopGrabbing() {
+    m_grabTimer.stop();
+    m_grabPacer.stop();
+    m_damageTracker->stop();
+}
+
+void Magnifier::updateWatchRect() {
+    const QPoint topLeft(m_curPos.x() - m_sourceSize.width() / 2, m_curPos.y() - m_sourceSize.height() / 2);
+    m_damageTracker->setWatchRect(QRect(topLeft, m_sourceSize));
+}
+
+void Magnifier::requestGrab() {
+    if (m_frozen || !m_damageDriven) {
+        return;
+    }
+
+    m_grabPacer.schedule();
 }
 
 void Magnifier::periodicGrab() {
-    grabScreen();
-    repaint();
+    m_capture->requestCapture(m_curPos, m_sourceSize);
 }
 
-void Magnifier::grabScreen() {
-    const int cx = m_width / 2;
-    const int cy = m_height / 2;
-    const int x = m_curPos.x() - cx;
-    const int y = m_curPos.y() - cy;
-    m_image = m_screenInfo->grabScreen(x, y, m_width, m_height);
+void Magnifier::frameCaptured() {
+    // The frame is picked up here rather than when painting so that the current color is reported even if the
+    // magnifier is not visible.
+    const MagnifierCapture::Frame& frame = m_capture->latestFrame();
 
-    const QRgb color = m_image.pixel(cx, cy);
-    if (color != m_currentColor) {
-        m_currentColor = color;
-        emit currentColorChanged(color);
+    if (frame.color != m_currentColor) {
+        m_currentColor = frame.color;
+        emit currentColorChanged(frame.color);
     }
+
+    update();
 }
 
 void Magnifier::paintEvent(QPaintEvent*) {
     QPainter painter(this);
 
-    // Image
-    painter.save();
-    painter.setTransform(m_zoomTransform);
-    painter.drawImage(0, 0, m_image);
-    painter.restore();
+    // Image. The center pixel of the captured frame, which is the pixel under the cursor, is drawn in the center
+    // marker regardless of how much of the screen was captured. The grid and center marker are drawn as the frame
+    // is enlarged.
+    const MagnifierCapture::Frame& frame = m_capture->currentFrame();
+    const QRect frameRect = (frame.sequence > 0) ? QRect(QPoint(0, 0), frame.size) : QRect();
+    const int zoomFactor = k_zoomFactors[m_zoomIndex];
+    const QPoint origin(m_centerMarker.x() - zoomFactor * (frameRect.width() / 2),
+                        m_centerMarker.y() - zoomFactor * (frameRect.height() / 2));
 
-    // Grid
+    PixelZoom::Overlay overlay;
     if (m_gridType != None && (m_zoomIndex >= k_gridMinIndex)) {
-        painter.setPen(m_gridType == Dark ? m_darkGridPen : m_lightGridPen);
-        painter.drawLines(m_gridLines.data(), static_cast<int>(m_gridLines.size()));
+        overlay.lines = m_gridLines.data();
+        overlay.lineCount = static_cast<int>(m_gridLines.size());
+        overlay.lineColor = (m_gridType == Dark) ? k_darkGridColor : k_lightGridColor;
     }
+    overlay.marker = m_centerMarker;
+    overlay.markerColor = k_centerMarkerColor;
 
-    // Center marker
-    painter.setPen(m_centerMarkerPen);
-    painter.drawRect(m_centerMarker);
+    PixelZoom::zoom(frame.image, frameRect, zoomFactor, origin, m_zoomedImage, overlay);
+    painter.drawImage(0, 0, m_zoomedImage);
 
     // Border
-    painter.setPen(m_darkGridPen);
+    painter.setPen(m_borderPen);
     painter.drawRect(0, 0, m_width - 1, m_height - 1);
 }
@@ -18,13 +18,16 @@
 #pragma once
 
 #include <meazure/environment/ScreenInfoProvider.h>
+#include <meazure/environment/ScreenDamageTracker.h>
 #include <meazure/config/Config.h>
 #include <meazure/tools/ToolMgr.h>
+#include <meazure/utils/RefreshPacer.h>
+#include "MagnifierCapture.h"
 #include <QWidget>
 #include <QPoint>
 #include <QImage>
 #include <QTimer>
-#include <QTransform>
+#include <QSize>
 #include <QPen>
 #include <QLine>
 #include <array>
@@ -46,6 +49,10 @@ public:
 
     using ZoomFactors = std::array<int, 8>;
 
+    static constexpr int k_defMaxRefreshRate { 60 };    ///< Default maximum refresh rate, in Hertz
+    static constexpr int k_minRefreshRate { 1 };        ///< Lowest settable maximum refresh rate, in Hertz
+    static constexpr int k_maxRefreshRate { 240 };      ///< Highest settable maximum refresh rate, in Hertz
+
     Magnifier(const ScreenInfoProvider* screenInfo, const ToolMgr* toolMgr);
 
     static constexpr const ZoomFactors& getZoomFactors() {
@@ -55,6 +62,21 @@ public:
     void writeConfig(Config& config) const;
     void readConfig(const Config& config);
 
+    /// Sets the maximum rate at which the magnifier refreshes when the screen contents under it are changing
+    /// continuously. The rate is only used when screen changes can be tracked. Otherwise the magnifier refreshes
+    /// at a fixed rate.
+    ///
+    /// @param[in] rate Maximum refresh rate, in Hertz. The rate is clamped to the range k_minRefreshRate to
+    ///     k_maxRefreshRate.
+    ///
+    void setMaxRefreshRate(int rate);
+
+    /// Obtains the time taken to capture the screen area shown in the magnifier.
+    ///
+    /// @return Capture time of the most recently displayed frame, in microseconds.
+    ///
+    [[nodiscard]] qint64 getCaptureLatency() const;
+
 public slots:
     void setZoom(int zoomIndex);
     void zoomIn();
@@ -73,30 +95,40 @@ protected:
 
 private slots:
     void setCurPos(QPoint rawPos);
+    void requestGrab();
     void periodicGrab();
+    void frameCaptured();
 
 private:
     static constexpr int k_size { 281 };        ///< Magnifier size, pixels
-    static constexpr int k_updateRate { 50 };   ///< Magnifier refresh rate, in milliseconds.
+    static constexpr int k_updateRate { 50 };   ///< Magnifier refresh rate if screen changes cannot be tracked, ms
     static constexpr ZoomFactors k_zoomFactors { 1, 2, 3, 4, 6, 8, 16, 32 };
     static constexpr int k_gridMinIndex { 4 };
+    static constexpr int k_guardBand { 1 };     ///< Source pixels grabbed beyond those visible at the current zoom
     static constexpr QRgb k_darkGridColor { qRgb(0, 0, 0) };
     static constexpr QRgb k_lightGridColor { qRgb(255, 255, 255) };
+    static constexpr QRgb k_centerMarkerColor { qRgb(255, 0, 0) };
 
-    void grabScreen();
+    void startGrabbing();
+    void stopGrabbing();
+    void updateWatchRect();
 
     const ScreenInfoProvider* m_screenInfo;
     int m_width { 0 };
     int m_height { 0 };
     QPoint m_curPos { -1, -1 };
-    QImage m_image;
-    QPen m_darkGridPen;
-    QPen m_lightGridPen;
-    QPen m_centerMarkerPen;
+    QImage m_zoomedImage;       ///< Reused image holding the enlarged frame, grid and center marker
+    QPen m_borderPen;
     QRect m_centerMarker;
-    QTimer m_grabTimer;
+    QTimer m_grabTimer;         ///< Grabs periodically when screen changes cannot be tracked
+    RefreshPacer m_grabPacer;   ///< Paces the grabs made on screen changes to the maximum refresh rate
+    ScreenDamageTracker* m_damageTracker;
+    MagnifierCapture* m_capture;
+    bool m_damageDriven { false };
+    bool m_frozen { false };
+    int m_maxRefreshRate { k_defMaxRefreshRate };
     int m_zoomIndex { 0 };
-    QTransform m_zoomTransform;
+    QSize m_sourceSize;         ///< Size of the screen area visible at the current zoom factor, pixels
     std::vector<QLine> m_gridLines;
     GridType m_gridType { Dark };
     QRgb m_currentColor { 1 };
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MagnifierCapture.h"
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <utility>
+
+
+MagnifierCapture::MagnifierCapture(const ScreenInfoProvider* screenInfo, const QSize& maxSize, QObject* parent) :
+        QThread(parent),
+        m_screenInfo(screenInfo),
+        m_maxSize(maxSize) {
+}
+
+MagnifierCapture::~MagnifierCapture() {
+    stop();
+}
+
+void MagnifierCapture::start() {
+    if (!m_screenInfo->isGrabThreadSafe()) {
+        return;
+    }
+
+    m_run = true;
+    QThread::start();
+}
+
+void MagnifierCapture::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    {
+        const QMutexLocker locker(&m_mutex);
+        m_run = false;
+        m_requestCondition.wakeOne();
+    }
+
+    wait();
+}
+
+void MagnifierCapture::requestCapture(const QPoint& position, const QSize& size) {
+    const QSize captureSize = size.boundedTo(m_maxSize);
+
+    if (!isRunning()) {
+        capture(position, captureSize);
+        return;
+    }
+
+    const QMutexLocker locker(&m_mutex);
+    m_requestPosition = position;
+    m_requestSize = captureSize;
+    m_requestPending = true;
+    m_requestCondition.wakeOne();
+}
+
+const MagnifierCapture::Frame& MagnifierCapture::latestFrame() {
+    m_notifyPending.store(false, std::memory_order_release);
+
+    if ((m_middle.load(std::memory_order_acquire) & k_freshFlag) != 0) {
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & k_indexMask;
+    }
+
+    return m_frames[m_front];      // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
+const MagnifierCapture::Frame& MagnifierCapture::currentFrame() const {
+    return m_frames[m_front];      // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
+void MagnifierCapture::run() {
+    QMutexLocker locker(&m_mutex);
+
+    while (m_run) {
+        if (!m_requestPending) {
+            m_requestCondition.wait(&m_mutex);
+            continue;
+        }
+
+        const QPoint position = m_requestPosition;
+        const QSize size = m_requestSize;
+        m_requestPending = false;
+
+        locker.unlock();
+        capture(position, size);
+        locker.relock();
+    }
+}
+
+void MagnifierCapture::capture(const QPoint& position, const QSize& size) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const int cx = size.width() / 2;
+    const int cy = size.height() / 2;
+    QImage image = m_screenInfo->grabScreen(position.x() - cx, position.y() - cy, size.width(), size.height());
+    if (image.isNull()) {
+        return;
+    }
+    if (image.format() != QImage::Format_RGB32) {
+        image.convertTo(QImage::Format_RGB32);
+    }
+
+    // The grabbed image is swapped into the frame rather than copied. An image wrapping a shared memory segment
+    // keeps the segment out of use by the grabber until the frame is overwritten by a later capture, so the grabber
+    // cycles through a segment per frame plus the one being grabbed.
+    Frame& frame = m_frames[m_back];      // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    const int width = std::min(image.width(), m_maxSize.width());
+    const int height = std::min(image.height(), m_maxSize.height());
+    frame.image = std::move(image);
+
+    frame.size = QSize(width, height);
+    frame.position = position;
+    frame.color = frame.image.pixel(std::min(cx, width - 1), std::min(cy, height - 1));
+    frame.latency = timer.nsecsElapsed() / 1000;
+    frame.sequence = ++m_sequence;
+
+    publish();
+}
+
+void MagnifierCapture::publish() {
+    m_back = m_middle.exchange(m_back | k_freshFlag, std::memory_order_acq_rel) & k_indexMask;
+
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        emit frameReady();
+    }
+}
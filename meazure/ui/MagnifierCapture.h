@@ -0,0 +1,135 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <meazure/environment/ScreenInfoProvider.h>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QImage>
+#include <QPoint>
+#include <QSize>
+#include <QRgb>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+
+/// Grabs the screen area shown by the magnifier on a worker thread so that the GUI thread does not wait on the
+/// X server. Captured frames are passed to the GUI thread through a triple buffer. The capture thread always has a
+/// frame to write into and the GUI thread always has a complete frame to paint, without either thread blocking the
+/// other. Grabbed images are placed in the frames without copying their pixels.
+///
+/// Requests are not queued. If the capture thread is busy when a capture is requested, only the most recent request
+/// is captured once the thread becomes available.
+///
+/// If the screen cannot be grabbed off the GUI thread, the capture is performed on the calling thread when it is
+/// requested.
+///
+class MagnifierCapture : public QThread {
+
+    Q_OBJECT
+
+public:
+    /// A captured area of the screen.
+    ///
+    struct Frame {
+        QImage image;               ///< Captured pixels, occupying the top left of the image
+        QSize size;                 ///< Size of the captured area, in pixels
+        QPoint position;            ///< Screen position at the center of the captured area, in pixels
+        QRgb color { 0 };           ///< Color of the pixel at the center of the captured area
+        qint64 latency { 0 };       ///< Time taken to capture the frame, in microseconds
+        quint64 sequence { 0 };     ///< Number of the capture, starting at 1. Zero if nothing has been captured.
+    };
+
+    /// Constructs the capture pipeline.
+    ///
+    /// @param[in] screenInfo Used to grab the screen
+    /// @param[in] maxSize Largest area that will be captured, in pixels
+    /// @param[in] parent Parent object for the pipeline
+    ///
+    MagnifierCapture(const ScreenInfoProvider* screenInfo, const QSize& maxSize, QObject* parent = nullptr);
+    ~MagnifierCapture() override;
+
+    MagnifierCapture(const MagnifierCapture&) = delete;
+    MagnifierCapture(MagnifierCapture&&) = delete;
+    MagnifierCapture& operator=(const MagnifierCapture&) = delete;
+
+    /// Starts the capture thread, if the screen can be grabbed off the GUI thread.
+    ///
+    void start();
+
+    /// Stops the capture thread and waits for it to finish.
+    ///
+    void stop();
+
+    /// Requests that an area of the screen be captured. The request replaces any request that has not yet been
+    /// started. The frameReady signal is emitted when the capture is available.
+    ///
+    /// @param[in] position Screen position at the center of the area to capture, in pixels
+    /// @param[in] size Size of the area to capture, in pixels. The size is limited to the maximum size specified
+    ///     when the pipeline was constructed.
+    ///
+    void requestCapture(const QPoint& position, const QSize& size);
+
+    /// Obtains the most recently captured frame. Only call this method from the GUI thread. The frame remains valid
+    /// until the next call to this method.
+    ///
+    /// @return Most recently captured frame. If no new frame has been captured since the last call, the same frame
+    ///     is returned.
+    ///
+    const Frame& latestFrame();
+
+    /// Obtains the frame returned by the last call to latestFrame. Only call this method from the GUI thread.
+    ///
+    /// @return Frame currently held by the GUI thread.
+    ///
+    [[nodiscard]] const Frame& currentFrame() const;
+
+signals:
+    /// Emitted when a new frame has been captured. The signal is not emitted again until latestFrame has been
+    /// called, so a slow GUI thread is not flooded with notifications.
+    ///
+    void frameReady();
+
+protected:
+    void run() override;
+
+private:
+    static constexpr int k_indexMask { 0x3 };       ///< Extracts the frame index from the shared slot
+    static constexpr int k_freshFlag { 0x4 };       ///< Indicates the shared slot holds an unread frame
+
+    void capture(const QPoint& position, const QSize& size);
+    void publish();
+
+    const ScreenInfoProvider* m_screenInfo;
+    QSize m_maxSize;
+    std::array<Frame, 3> m_frames;
+    int m_back { 0 };                               ///< Frame being written by the capture thread
+    std::atomic<int> m_middle { 1 };                ///< Frame exchanged between the threads, plus k_freshFlag
+    int m_front { 2 };                              ///< Frame held by the GUI thread
+    std::atomic<bool> m_notifyPending { false };
+    quint64 m_sequence { 0 };
+
+    QMutex m_mutex;
+    QWaitCondition m_requestCondition;
+    bool m_run { false };
+    bool m_requestPending { false };
+    QPoint m_requestPosition;
+    QSize m_requestSize;
+};
@@ -103,5 +103,6 @@ void MagnifierSection::hardReset() {
     m_magnifier->setGridType(k_initialGridType);
     m_magnifier->setFreeze(k_initialFreeze);
     m_magnifier->setZoom(k_initialZoomIndex);
+    m_magnifier->setMaxRefreshRate(Magnifier::k_defMaxRefreshRate);
     m_colorDisplay->setColorFormat(RGBFmt);
 }
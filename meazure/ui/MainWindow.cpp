@@ -17,6 +17,7 @@
 
 #include "MainWindow.h"
 #include "GlobalShortcuts.h"
+#include "ImageMimeData.h"
 #include <meazure/tools/CircleTool.h>
 #include <meazure/tools/CursorTool.h>
 #include <meazure/tools/GridTool.h>
@@ -844,7 +845,11 @@ void MainWindow::copyRegion() {
     if (radioTool->canGrabRegion()) {
         const QImage image = radioTool->grabRegion();
         if (!image.isNull()) {
-            QGuiApplication::clipboard()->setImage(image);
+            // The image is only encoded when a format is requested. Almost every paste target requests PNG, so its
+            // encoding is started in the background immediately.
+            auto* mimeData = new ImageMimeData(image);
+            mimeData->prepare(ImageMimeData::k_pngFormat);
+            QGuiApplication::clipboard()->setMimeData(mimeData);
         }
         radioTool->flash();
     }
@@ -27,9 +27,7 @@ ScreenDataSection::ScreenDataSection(const ScreenInfo* screenInfo, const UnitsMg
         m_unitsMgr(unitsMgr) {
     createFields();
 
-    connect(toolMgr, &ToolMgr::xy1PositionChanged, this, &ScreenDataSection::update);
-    connect(toolMgr, &ToolMgr::xy2PositionChanged, this, &ScreenDataSection::update);
-    connect(toolMgr, &ToolMgr::xyvPositionChanged, this, &ScreenDataSection::update);
+    connect(toolMgr, &ToolMgr::measurementChanged, this, &ScreenDataSection::measurementChanged);
 
     connect(m_unitsMgr, &UnitsMgr::linearUnitsChanged, this, &ScreenDataSection::linearUnitsChanged);
     connect(m_unitsMgr, &UnitsMgr::precisionsChanged, this, &ScreenDataSection::linearUnitsChanged);
@@ -104,7 +102,19 @@ void ScreenDataSection::createFields() {
     setLayout(layout);
 }
 
-void ScreenDataSection::update(QPointF, QPoint rawPos) {
+void ScreenDataSection::measurementChanged(const MeasurementSnapshot& snapshot) {
+    if (snapshot.hasChanged(XY1Changed)) {
+        updateScreen(snapshot.rawPos1);
+    }
+    if (snapshot.hasChanged(XY2Changed)) {
+        updateScreen(snapshot.rawPos2);
+    }
+    if (snapshot.hasChanged(XYVChanged)) {
+        updateScreen(snapshot.rawPosV);
+    }
+}
+
+void ScreenDataSection::updateScreen(const QPoint& rawPos) {
     const int screenIdx = m_screenInfo->screenForPoint(rawPos);
     if (screenIdx != m_currentScreenIdx) {
         m_currentScreenIdx = screenIdx;
@@ -21,11 +21,11 @@
 #include <meazure/units/UnitsMgr.h>
 #include <meazure/environment/ScreenInfo.h>
 #include <meazure/tools/ToolMgr.h>
+#include <meazure/measurement/MeasurementSnapshot.h>
 #include <meazure/prefs/ui/PrefsDialog.h>
 #include "fields/DoubleDataField.h"
 #include <QGroupBox>
 #include <QLabel>
-#include <QPointF>
 #include <QPoint>
 #include <QPushButton>
 
@@ -42,7 +42,7 @@ public:
 
 private slots:
     void linearUnitsChanged();
-    void update(QPointF coord, QPoint rawPos);
+    void measurementChanged(const MeasurementSnapshot& snapshot);
 
 private:
     static constexpr int k_fieldWidth { 7 };
@@ -53,6 +53,12 @@ private:
 
     void refresh();
 
+    /// Displays the information for the screen containing the specified position, if it is not already displayed.
+    ///
+    /// @param[in] rawPos Screen position in pixels
+    ///
+    void updateScreen(const QPoint& rawPos);
+
     const ScreenInfo* m_screenInfo;
     const UnitsMgr* m_unitsMgr;
     int m_currentScreenIdx { -1 };
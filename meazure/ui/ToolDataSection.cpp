@@ -27,14 +27,7 @@ ToolDataSection::ToolDataSection(const UnitsMgr* unitsMgr, const ToolMgr* toolMg
     createFields();
 
     connect(toolMgr, &ToolMgr::radioToolSelected, this, &ToolDataSection::radioToolSelected);
-    connect(toolMgr, &ToolMgr::xy1PositionChanged, this, &ToolDataSection::xy1PositionChanged);
-    connect(toolMgr, &ToolMgr::xy2PositionChanged, this, &ToolDataSection::xy2PositionChanged);
-    connect(toolMgr, &ToolMgr::xyvPositionChanged, this, &ToolDataSection::xyvPositionChanged);
-    connect(toolMgr, &ToolMgr::widthHeightChanged, this, &ToolDataSection::widthHeightChanged);
-    connect(toolMgr, &ToolMgr::distanceChanged, this, &ToolDataSection::distanceChanged);
-    connect(toolMgr, &ToolMgr::angleChanged, this, &ToolDataSection::angleChanged);
-    connect(toolMgr, &ToolMgr::aspectChanged, this, &ToolDataSection::aspectChanged);
-    connect(toolMgr, &ToolMgr::areaChanged, this, &ToolDataSection::areaChanged);
+    connect(toolMgr, &ToolMgr::measurementChanged, this, &ToolDataSection::measurementChanged);
 
     connect(m_x1Field, &DoubleDataField::valueChanged, toolMgr, &ToolMgr::setX1Position);
     connect(m_y1Field, &DoubleDataField::valueChanged, toolMgr, &ToolMgr::setY1Position);
@@ -250,38 +243,33 @@ void ToolDataSection::angularUnitsChanged() {
     m_aField->setDecimals(angularUnits->getDisplayPrecision(Angle));
 }
 
-void ToolDataSection::xy1PositionChanged(QPointF coord, QPoint) {
-    m_x1Field->setValueQuietly(coord.x());
-    m_y1Field->setValueQuietly(coord.y());
-}
-
-void ToolDataSection::xy2PositionChanged(QPointF coord, QPoint) {
-    m_x2Field->setValueQuietly(coord.x());
-    m_y2Field->setValueQuietly(coord.y());
-}
-
-void ToolDataSection::xyvPositionChanged(QPointF coord, QPoint) {
-    m_xvField->setValueQuietly(coord.x());
-    m_yvField->setValueQuietly(coord.y());
-}
-
-void ToolDataSection::widthHeightChanged(QSizeF widthHeight) {
-    m_wField->setValue(widthHeight.width());
-    m_hField->setValue(widthHeight.height());
-}
-
-void ToolDataSection::distanceChanged(double distance) {
-    m_dField->setValue(distance);
-}
-
-void ToolDataSection::angleChanged(double angle) {
-    m_aField->setValue(angle);
-}
-
-void ToolDataSection::aspectChanged(double aspect) {
-    m_asField->setValue(aspect);
-}
-
-void ToolDataSection::areaChanged(double area) {
-    m_arField->setValue(area);
+void ToolDataSection::measurementChanged(const MeasurementSnapshot& snapshot) {
+    if (snapshot.hasChanged(XY1Changed)) {
+        m_x1Field->setValueQuietly(snapshot.coord1.x());
+        m_y1Field->setValueQuietly(snapshot.coord1.y());
+    }
+    if (snapshot.hasChanged(XY2Changed)) {
+        m_x2Field->setValueQuietly(snapshot.coord2.x());
+        m_y2Field->setValueQuietly(snapshot.coord2.y());
+    }
+    if (snapshot.hasChanged(XYVChanged)) {
+        m_xvField->setValueQuietly(snapshot.coordV.x());
+        m_yvField->setValueQuietly(snapshot.coordV.y());
+    }
+    if (snapshot.hasChanged(WHChanged)) {
+        m_wField->setValue(snapshot.widthHeight.width());
+        m_hField->setValue(snapshot.widthHeight.height());
+    }
+    if (snapshot.hasChanged(DistChanged)) {
+        m_dField->setValue(snapshot.distance);
+    }
+    if (snapshot.hasChanged(AngleChanged)) {
+        m_aField->setValue(snapshot.angle);
+    }
+    if (snapshot.hasChanged(AspectChanged)) {
+        m_asField->setValue(snapshot.aspect);
+    }
+    if (snapshot.hasChanged(AreaChanged)) {
+        m_arField->setValue(snapshot.area);
+    }
 }
@@ -22,6 +22,7 @@
 #include <meazure/units/UnitsMgr.h>
 #include <meazure/units/Units.h>
 #include <meazure/tools/ToolMgr.h>
+#include <meazure/measurement/MeasurementSnapshot.h>
 #include <QGroupBox>
 #include <QLabel>
 
@@ -50,56 +51,12 @@ private slots:
     ///
     void angularUnitsChanged();
 
-    /// Called when a tool's position 1 has changed.
+    /// Called when the current tool has made a measurement. Only the fields corresponding to the changed
+    /// measurements are updated.
     ///
-    /// @param[in] coord Coordinates for the position in the current units, origin and y-axis direction
-    /// @param[in] rawPos Screen position in pixels
+    /// @param[in] snapshot Measurements made by the tool
     ///
-    void xy1PositionChanged(QPointF coord, QPoint rawPos);
-
-    /// Called when a tool's position 2 has changed.
-    ///
-    /// @param[in] coord Coordinates for the position in the current units, origin and y-axis direction
-    /// @param[in] rawPos Screen position in pixels
-    ///
-    void xy2PositionChanged(QPointF coord, QPoint rawPos);
-
-    /// Called when a tool's vertex position has changed.
-    ///
-    /// @param[in] coord Coordinates for the position in the current units, origin and y-axis direction
-    /// @param[in] rawPos Screen position in pixels
-    ///
-    void xyvPositionChanged(QPointF coord, QPoint rawPos);
-
-    /// Called when a tool's width and height change
-    ///
-    /// @param[in] widthHeight New width and height in the current units
-    ///
-    void widthHeightChanged(QSizeF widthHeight);
-
-    /// Called when the current tool's distance has changed (e.g. hypot of the Rectangle tool).
-    ///
-    /// @param[in] distance Tool distance in the current linear units.
-    ///
-    void distanceChanged(double distance);
-
-    /// Called when the current tool's angle has changed.
-    ///
-    /// @param[in] angle Tool angle in the current angular units.
-    ///
-    void angleChanged(double angle);
-
-    /// Called when the current tool's aspect ratio has changed (e.g. Rectangle tool aspect ratio).
-    ///
-    /// @param[in] aspect Tool aspect ratio
-    ///
-    void aspectChanged(double aspect);
-
-    /// Called when the current tool's area has changed (e.g. area of the Rectangle tool).
-    ///
-    /// @param[in] area Tool area
-    ///
-    void areaChanged(double area);
+    void measurementChanged(const MeasurementSnapshot& snapshot);
 
 private:
     static constexpr int k_fieldShortWidth { 7 };   // Characters
@@ -132,12 +132,14 @@ void CustomUnits::setScaleBasis(const QString& scaleBasisStr) {
 
 void CustomUnits::setScaleBasis(ScaleBasis scaleBasis) {
     m_scaleBasis = scaleBasis;
+    invalidateScreenFactors();
 
     emit customUnitsChanged();
 }
 
 void CustomUnits::setScaleFactor(double scaleFactor) {
     m_scaleFactor = scaleFactor;
+    invalidateScreenFactors();
 
     emit customUnitsChanged();
 }
@@ -20,6 +20,7 @@
 #include <QtMath>
 #include <QRect>
 #include <cmath>
+#include <algorithm>
 
 
 //*************************************************************************
@@ -138,28 +139,12 @@ QString LinearUnits::getResLabel() const {
 }
 
 QPointF LinearUnits::convertCoord(const QPoint& pos) const {
-    const int screenIndex = m_screenInfoProvider->screenForPoint(pos);
-    const QSizeF from = fromPixels(m_screenInfoProvider->getScreenRes(screenIndex));
-    QPointF fpos;
-
-    fpos.rx() = from.width() * (pos.x() - m_originOffset.x());
-
-    if (m_invertY) {
-        if ((m_originOffset.x() == 0) && (m_originOffset.y() == 0)) {
-            fpos.ry() = from.height() * (m_screenInfoProvider->getVirtualRect().height() - 1 - pos.y());
-        } else {
-            fpos.ry() = from.height() * (m_originOffset.y() - pos.y());
-        }
-    } else {
-        fpos.ry() = from.height() * (pos.y() - m_originOffset.y());
-    }
-
-    return fpos;
+    const ScreenFactors& factors = getScreenFactors(m_screenInfoProvider->screenForPoint(pos));
+    return { toUnits(ConvertX, factors, pos.x()), toUnits(ConvertY, factors, pos.y()) };
 }
 
 QPointF LinearUnits::convertPos(const QPoint& pos) const {
-    const int screenIndex = m_screenInfoProvider->screenForPoint(pos);
-    const QSizeF from = fromPixels(m_screenInfoProvider->getScreenRes(screenIndex));
+    const QSizeF& from = getScreenFactors(m_screenInfoProvider->screenForPoint(pos)).fromPixels;
     const double x = from.width() * pos.x();
     const double y = from.height() * pos.y();
     return { x, y };
@@ -170,30 +155,19 @@ QSizeF LinearUnits::convertRes(const QSizeF& res) const {
 }
 
 double LinearUnits::unconvertCoord(ConvertDir dir, const QWidget* wnd, double pos) const {
-    const int screenIndex = m_screenInfoProvider->screenForWindow(wnd);
-    const QSizeF from = fromPixels(m_screenInfoProvider->getScreenRes(screenIndex));
-
-    if (dir == ConvertX) {
-        return pos / from.width() + m_originOffset.x();
-    }
-
-    if (m_invertY) {
-        if ((m_originOffset.x() == 0) && (m_originOffset.y() == 0)) {
-            return  (m_screenInfoProvider->getVirtualRect().height() - 1) - pos / from.height();
-        }
-        return  m_originOffset.y() - pos / from.height();
-    }
-    return pos / from.height() + m_originOffset.y();
+    return toPixels(dir, getScreenFactors(m_screenInfoProvider->screenForWindow(wnd)), pos);
 }
 
 bool LinearUnits::unconvertCoord(ConvertDir dir, const QWidget* wnd, double pos, int& c1, int& c2) const {
-    const int p1 = static_cast<int>(unconvertCoord(dir, wnd, pos));
+    const ScreenFactors& factors = getScreenFactors(m_screenInfoProvider->screenForWindow(wnd));
+
+    const int p1 = static_cast<int>(toPixels(dir, factors, pos));
     const int p2 = p1 - 1;
     const int p3 = p1 + 1;
 
-    const double l1 = convertCoord(dir, wnd, p1);
-    const double l2 = convertCoord(dir, wnd, p2);
-    const double l3 = convertCoord(dir, wnd, p3);
+    const double l1 = toUnits(dir, factors, p1);
+    const double l2 = toUnits(dir, factors, p2);
+    const double l3 = toUnits(dir, factors, p3);
 
     const double d1 = fabs(pos - l1);
     const double d2 = fabs(pos - l2);
@@ -226,29 +200,128 @@ bool LinearUnits::unconvertCoord(ConvertDir dir, const QWidget* wnd, double pos,
 }
 
 QPoint LinearUnits::unconvertCoord(const QPointF& pos) const {
-    const QSizeF from = fromPixels(findResFromCoord(pos));
+    const ScreenFactors& factors = findFactorsFromCoord(pos);
+    return { qRound(toPixels(ConvertX, factors, pos.x())), qRound(toPixels(ConvertY, factors, pos.y())) };
+}
+
+QPoint LinearUnits::unconvertPos(const QPointF& pos) const {
+    const QSizeF& from = findFactorsFromPos(pos).fromPixels;
+    const int x = static_cast<int>(pos.x() / from.width());
+    const int y = static_cast<int>(pos.y() / from.height());
+    return { x, y };
+}
 
-    QPoint point;
-    point.rx() = qRound(pos.x() / from.width() + m_originOffset.x());
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 
-    if (m_invertY) {
-        if ((m_originOffset.x() == 0) && (m_originOffset.y() == 0)) {
-            point.ry() = qRound((m_screenInfoProvider->getVirtualRect().height() - 1) - pos.y() / from.height());
-        } else {
-            point.ry() = qRound(m_originOffset.y() - pos.y() / from.height());
+void LinearUnits::convertCoords(const QPoint* pos, QPointF* coords, int count) const {
+    if (count <= 0) {
+        return;
+    }
+
+    // Obtaining the factors brings the inverted origin up to date.
+    const ScreenFactors* factors = &getScreenFactors(m_screenInfoProvider->screenForPoint(pos[0]));
+
+    // The y-axis conversion is expressed as signY * y - offsetY so that the loop below does not branch on the
+    // orientation of the axis. The integer arithmetic is the same as that of toUnits, so the results are identical.
+    const int offsetX = m_originOffset.x();
+    const int signY = m_invertY ? -1 : 1;
+    const int offsetY = m_invertY ? -m_invertedOriginY : m_originOffset.y();
+
+    int start = 0;
+    while (start < count) {
+        // Find the run of coordinates on the same screen as the first one.
+        // A position on the current screen is on the same screen as the first one, unless an earlier screen overlaps
+        // the current one, in which case the earlier screen takes precedence.
+        const ScreenFactors* nextFactors = nullptr;
+        const bool sameScreenCheck = !factors->screenOverlap;
+        int end = start + 1;
+        for (; end < count; end++) {
+            if (sameScreenCheck && factors->screenRect.contains(pos[end])) {
+                continue;
+            }
+            nextFactors = &getScreenFactors(m_screenInfoProvider->screenForPoint(pos[end]));
+            if (nextFactors != factors) {
+                break;
+            }
         }
-    } else {
-        point.ry() = qRound(pos.y() / from.height() + m_originOffset.y());
+
+        const double fromX = factors->fromPixels.width();
+        const double fromY = factors->fromPixels.height();
+        for (int i = start; i < end; i++) {
+            coords[i] = QPointF(fromX * (pos[i].x() - offsetX), fromY * (signY * pos[i].y() - offsetY));
+        }
+
+        start = end;
+        factors = nextFactors;
     }
+}
+
+void LinearUnits::unconvertCoords(const QPointF* coords, QPoint* pos, int count) const {
+    if (count <= 0) {
+        return;
+    }
+
+    const ScreenFactors* factors = &findFactorsFromCoord(coords[0]);
+
+    // See convertCoords for a description of the y-axis conversion. Negating the quotient and adding it is the same
+    // as subtracting it, so the results are identical to those of toPixels.
+    const double offsetX = m_originOffset.x();
+    const double signY = m_invertY ? -1.0 : 1.0;
+    const double offsetY = m_invertY ? m_invertedOriginY : m_originOffset.y();
+
+    int start = 0;
+    while (start < count) {
+        const ScreenFactors* nextFactors = nullptr;
+        const bool sameScreenCheck = !factors->coordOverlap;
+        int end = start + 1;
+        for (; end < count; end++) {
+            if (sameScreenCheck && factors->coordRect.contains(coords[end])) {
+                continue;
+            }
+            nextFactors = &findFactorsFromCoord(coords[end]);
+            if (nextFactors != factors) {
+                break;
+            }
+        }
+
+        const double fromX = factors->fromPixels.width();
+        const double fromY = factors->fromPixels.height();
+        for (int i = start; i < end; i++) {
+            const double x = coords[i].x() / fromX + offsetX;
+            const double y = signY * (coords[i].y() / fromY) + offsetY;
+            pos[i] = QPoint(qRound(x), qRound(y));
+        }
 
-    return point;
+        start = end;
+        factors = nextFactors;
+    }
 }
 
-QPoint LinearUnits::unconvertPos(const QPointF& pos) const {
-    const QSizeF from = fromPixels(findResFromPos(pos));
-    const int x = static_cast<int>(pos.x() / from.width());
-    const int y = static_cast<int>(pos.y() / from.height());
-    return { x, y };
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+QSizeF LinearUnits::getWidthHeight(const QPoint& p1, const QPoint& p2) const {
+    const QSizeF& from1 = getScreenFactors(m_screenInfoProvider->screenForPoint(p1)).fromPixels;
+    const QSizeF& from2 = getScreenFactors(m_screenInfoProvider->screenForPoint(p2)).fromPixels;
+
+    QPoint np1(p1);
+    QPoint np2(p2);
+
+    if (np1.x() < np2.x()) {
+        np2.rx()++;
+    } else {
+        np1.rx()++;
+    }
+
+    if (np1.y() < np2.y()) {
+        np2.ry()++;
+    } else {
+        np1.ry()++;
+    }
+
+    const QPointF cp1(from1.width() * np1.x(), from1.height() * np1.y());
+    const QPointF cp2(from2.width() * np2.x(), from2.height() * np2.y());
+
+    return { fabs(cp1.x() - cp2.x()), fabs(cp1.y() - cp2.y()) };
 }
 
 QSize LinearUnits::convertToPixels(const QSizeF& res, double value, int minPixels) const {
@@ -272,50 +345,111 @@ QSizeF LinearUnits::getResFromPixels(const QSizeF& res) const {
 }
 
 double LinearUnits::convertCoord(ConvertDir dir, const QWidget* wnd, int pos) const {
-    const int screenIndex = m_screenInfoProvider->screenForWindow(wnd);
-    const QSizeF from = fromPixels(m_screenInfoProvider->getScreenRes(screenIndex));
+    return toUnits(dir, getScreenFactors(m_screenInfoProvider->screenForWindow(wnd)), pos);
+}
 
-    if (dir == ConvertX) {
-        return from.width() * (pos - m_originOffset.x());
+const LinearUnits::ScreenFactors& LinearUnits::getScreenFactors(int screenIndex) const {
+    if (!m_screenFactorsValid) {
+        updateScreenFactors();
     }
 
-    if (m_invertY) {
-        if ((m_originOffset.x() == 0) && (m_originOffset.y() == 0)) {
-            return from.height() * (m_screenInfoProvider->getVirtualRect().height() - 1 - pos);
-        }
-        return from.height() * (m_originOffset.y() - pos);
+    const int numScreens = static_cast<int>(m_screenFactors.size()) - 1;
+    const bool validScreen = (screenIndex >= 0) && (screenIndex < numScreens);
+    return m_screenFactors[validScreen ? static_cast<std::size_t>(screenIndex) : m_screenFactors.size() - 1];
+}
+
+const LinearUnits::ScreenFactors& LinearUnits::findFactorsFromCoord(const QPointF& pos) const {
+    if (!m_screenFactorsValid) {
+        updateScreenFactors();
+    }
+
+    const auto iter = std::find_if(m_screenFactors.begin(), m_screenFactors.end() - 1,
+                                   [&pos](const ScreenFactors& factors) { return factors.coordRect.contains(pos); });
+    return *iter;
+}
+
+const LinearUnits::ScreenFactors& LinearUnits::findFactorsFromPos(const QPointF& pos) const {
+    if (!m_screenFactorsValid) {
+        updateScreenFactors();
     }
-    return from.height() * (pos - m_originOffset.y());
+
+    const auto iter = std::find_if(m_screenFactors.begin(), m_screenFactors.end() - 1,
+                                   [&pos](const ScreenFactors& factors) { return factors.posRect.contains(pos); });
+    return *iter;
 }
 
-QSizeF LinearUnits::findResFromCoord(const QPointF& pos) const {
-    for (int i = 0; i < m_screenInfoProvider->getNumScreens(); i++) {
-        const QRect screenRect = m_screenInfoProvider->getScreenRect(i);
-        const QPointF tl = convertCoord(screenRect.topLeft());
-        const QPointF br = convertCoord(screenRect.bottomRight());
-        const QRectF convertedScreenRect = QRectF(tl, br).normalized();
+void LinearUnits::updateScreenFactors() const {
+    const QRect virtualRect = m_screenInfoProvider->getVirtualRect();
+    const bool systemOrigin = (m_originOffset.x() == 0) && (m_originOffset.y() == 0);
+    m_invertedOriginY = systemOrigin ? virtualRect.height() - 1 : m_originOffset.y();
 
-        if (convertedScreenRect.contains(pos)) {
-            return m_screenInfoProvider->getScreenRes(i);
+    const int numScreens = m_screenInfoProvider->getNumScreens();
+    m_screenFactors.resize(static_cast<std::size_t>(numScreens) + 1);
+
+    for (int i = 0; i < numScreens; i++) {
+        ScreenFactors& factors = m_screenFactors[static_cast<std::size_t>(i)];
+        factors.fromPixels = fromPixels(m_screenInfoProvider->getScreenRes(i));
+
+        const QRect screenRect = m_screenInfoProvider->getScreenRect(i);
+        const QPointF tlCoord(toUnits(ConvertX, factors, screenRect.left()),
+                              toUnits(ConvertY, factors, screenRect.top()));
+        const QPointF brCoord(toUnits(ConvertX, factors, screenRect.right()),
+                              toUnits(ConvertY, factors, screenRect.bottom()));
+        factors.coordRect = QRectF(tlCoord, brCoord).normalized();
+
+        const QPointF tlPos(factors.fromPixels.width() * screenRect.left(),
+                            factors.fromPixels.height() * screenRect.top());
+        const QPointF brPos(factors.fromPixels.width() * screenRect.right(),
+                            factors.fromPixels.height() * screenRect.bottom());
+        factors.posRect = QRectF(tlPos, brPos).normalized();
+
+        // Screens are searched in order, so a position in an overlap belongs to the earlier screen. Coordinate
+        // rectangles contain their edges, so rectangles that only share an edge are considered to overlap.
+        factors.screenRect = screenRect;
+        factors.screenOverlap = false;
+        factors.coordOverlap = false;
+        for (int j = 0; j < i; j++) {
+            const ScreenFactors& earlier = m_screenFactors[static_cast<std::size_t>(j)];
+            const QRectF& r1 = earlier.coordRect;
+            const QRectF& r2 = factors.coordRect;
+            factors.screenOverlap = factors.screenOverlap || earlier.screenRect.intersects(screenRect);
+            factors.coordOverlap = factors.coordOverlap || (r1.left() <= r2.right() && r2.left() <= r1.right() &&
+                                                            r1.top() <= r2.bottom() && r2.top() <= r1.bottom());
         }
     }
 
-    return { 0.0, 0.0 };
+    // Positions that are not on any screen are converted using a zero resolution, as reported for an invalid screen.
+    ScreenFactors& offScreen = m_screenFactors.back();
+    offScreen.fromPixels = fromPixels(QSizeF(0.0, 0.0));
+    offScreen.coordRect = QRectF();
+    offScreen.posRect = QRectF();
+    offScreen.screenRect = QRect();
+    offScreen.screenOverlap = false;
+    offScreen.coordOverlap = false;
+
+    m_screenFactorsValid = true;
 }
 
-QSizeF LinearUnits::findResFromPos(const QPointF& pos) const {
-    for (int i = 0; i < m_screenInfoProvider->getNumScreens(); i++) {
-        const QRect screenRect = m_screenInfoProvider->getScreenRect(i);
-        const QPointF tl = convertPos(screenRect.topLeft());
-        const QPointF br = convertPos(screenRect.bottomRight());
-        const QRectF convertedScreenRect = QRectF(tl, br).normalized();
+double LinearUnits::toUnits(ConvertDir dir, const ScreenFactors& factors, int pos) const {
+    if (dir == ConvertX) {
+        return factors.fromPixels.width() * (pos - m_originOffset.x());
+    }
 
-        if (convertedScreenRect.contains(pos)) {
-            return m_screenInfoProvider->getScreenRes(i);
-        }
+    if (m_invertY) {
+        return factors.fromPixels.height() * (m_invertedOriginY - pos);
+    }
+    return factors.fromPixels.height() * (pos - m_originOffset.y());
+}
+
+double LinearUnits::toPixels(ConvertDir dir, const ScreenFactors& factors, double pos) const {
+    if (dir == ConvertX) {
+        return pos / factors.fromPixels.width() + m_originOffset.x();
     }
 
-    return { 0.0, 0.0 };
+    if (m_invertY) {
+        return m_invertedOriginY - pos / factors.fromPixels.height();
+    }
+    return pos / factors.fromPixels.height() + m_originOffset.y();
 }
 
 
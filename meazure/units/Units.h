@@ -26,11 +26,14 @@
 #include <QPointF>
 #include <QSize>
 #include <QSizeF>
-#include <QWidget>
+#include <QRectF>
 #include <limits>
 #include <array>
 
 
+class QWidget;
+
+
 /// Identifiers for linear measurement units.
 ///
 enum LinearUnitsId {
@@ -386,7 +389,10 @@ public:
     /// @param[in] invertY true inverts the y-axis, placing the origin at the lower left of the primary
     ///         display screen and making positive y pointing upward.
     ///
-    void setInvertY(bool invertY) { m_invertY = invertY; }
+    void setInvertY(bool invertY) {
+        m_invertY = invertY;
+        invalidateScreenFactors();
+    }
 
     /// Returns the orientation of the y-axis.
     ///
@@ -402,7 +408,10 @@ public:
     ///
     /// @param[in] origin New location for the origin of the coordinate system, in pixels.
     ///
-    void setOrigin(const QPoint& origin) { m_originOffset = origin; }
+    void setOrigin(const QPoint& origin) {
+        m_originOffset = origin;
+        invalidateScreenFactors();
+    }
 
     /// Returns the location of the origin of the coordinate system.
     ///
@@ -410,6 +419,12 @@ public:
     ///
     [[nodiscard]] const QPoint& getOrigin() const { return m_originOffset; }
 
+    /// The factors to convert between pixels and the units are precomputed for each screen. This method discards
+    /// those factors so that they are recomputed when next used. Call this method when a screen resolution changes
+    /// (e.g. the screen is calibrated) or when the value returned by the fromPixels method otherwise changes.
+    ///
+    void invalidateScreenFactors() { m_screenFactorsValid = false; }
+
     /// Internally all measurements are in pixels. Measurement units based solely on pixels do not require the use of
     /// the screen resolution for conversion. Measurement units such as inches, require the screen resolution for
     /// conversion from pixels. This method indicates whether the screen resolution is required for conversion from
@@ -542,6 +557,41 @@ public:
     ///
     [[nodiscard]] QPoint unconvertPos(const QPointF& pos) const;
 
+    /// Converts the specified coordinates from pixels to the desired units. The result for each coordinate is
+    /// identical to that of convertCoord. Consecutive coordinates on the same screen are converted together using
+    /// that screen's conversion factors. The screen is only looked up for a coordinate that is not on the screen of
+    /// the preceding coordinate.
+    ///
+    /// @param[in] pos Coordinates in pixels to convert to the desired units.
+    /// @param[out] coords Receives the converted coordinates. Must have room for count coordinates.
+    /// @param[in] count Number of coordinates to convert.
+    ///
+    void convertCoords(const QPoint* pos, QPointF* coords, int count) const;
+
+    /// Converts the specified coordinates from the current units to pixels. The result for each coordinate is
+    /// identical to that of unconvertCoord(const QPointF&). Consecutive coordinates on the same screen are converted
+    /// together using that screen's conversion factors. The screen is only looked up for a coordinate that is not on
+    /// the screen of the preceding coordinate.
+    ///
+    /// @param[in] coords Coordinates to convert to pixels.
+    /// @param[out] pos Receives the converted coordinates. Must have room for count coordinates.
+    /// @param[in] count Number of coordinates to convert.
+    ///
+    void unconvertCoords(const QPointF* coords, QPoint* pos, int count) const;
+
+    /// Converts the two specified points from pixels to the desired units, and then calculates the width and height
+    /// of the rectangle formed by the two points.
+    ///
+    /// @param[in] p1 One point defining the rectangle, in pixels.
+    /// @param[in] p2 The other point defining the rectangle, in pixels.
+    ///
+    /// @return The width and height of the rectangle formed by the two specified points converted to the desired
+    ///         units. Regardless of the relative locations of the two points, the width and height are always
+    ///         positive. In addition, the width and height are inclusive (e.g. p1.x = 1, p2.x = 3,
+    ///         width = p2.x - p1.x + 1 = 3).
+    ///
+    [[nodiscard]] QSizeF getWidthHeight(const QPoint& p1, const QPoint& p2) const;
+
     /// Converts the specified value from the current units to pixels. A minimum pixel value is specified in case the
     /// resolution is such that the conversion to pixels results in a value that is too small.
     ///
@@ -598,33 +648,71 @@ protected:
     ///
     double convertCoord(ConvertDir dir, const QWidget* wnd, int pos) const;
 
-    /// In a multiple monitor environment there are multiple screen resolutions, one set per monitor. Therefore, to
-    /// determine the a resolution, a screen must be determined. This method uses the specified position to determined
-    /// a screen and thus a resolution. The method compensates for the location of the origin and the orientation of
-    /// the y-axis.
+private:
+    /// Conversion factors and screen bounds precomputed for a display screen.
     ///
-    /// @param[in] pos Position used to determine a screen and thus a resolution, in the current units.
+    struct ScreenFactors {
+        QSizeF fromPixels;      ///< Factors to convert from pixels to the units for the screen's resolution
+        QRectF coordRect;       ///< Screen bounds in the units, compensating for the origin and y-axis orientation
+        QRectF posRect;         ///< Screen bounds in the units, not compensating for the origin or y-axis orientation
+        QRect screenRect;       ///< Screen bounds in pixels
+        bool screenOverlap;     ///< screenRect overlaps the screenRect of a preceding screen
+        bool coordOverlap;      ///< coordRect overlaps the coordRect of a preceding screen
+    };
+
+    /// Obtains the precomputed conversion factors for the specified screen, recomputing the factors for all
+    /// screens if they have been invalidated.
     ///
-    /// @return Screen resolution, in the current units.
+    /// @param[in] screenIndex Index of the screen. If the index does not identify a screen (e.g. -1 because a
+    ///     position is not on any screen), the factors for a zero resolution are returned.
+    /// @return Conversion factors for the screen.
     ///
-    [[nodiscard]] QSizeF findResFromCoord(const QPointF& pos) const;
+    [[nodiscard]] const ScreenFactors& getScreenFactors(int screenIndex) const;
 
-    /// In a multiple monitor environment there are multiple screen resolutions, one set per monitor. Therefore, to
-    /// determine the a resolution, a screen must be determined. This method uses the specified position to determined
-    /// a screen and thus a resolution. The method does not compensate for the location of the origin nor the
-    /// orientation of the y-axis.
+    /// In a multiple monitor environment there are multiple screen resolutions, one set per monitor. This method
+    /// finds the screen containing the specified position and returns its conversion factors. The method
+    /// compensates for the location of the origin and the orientation of the y-axis.
     ///
-    /// @param[in] pos Position used to determine a screen and thus a resolution, in the current units.
+    /// @param[in] pos Position used to determine a screen, in the current units.
+    /// @return Conversion factors for the screen containing the position, or the factors for a zero resolution if
+    ///     the position is not on any screen.
     ///
-    /// @return Screen resolution, in the current units.
+    [[nodiscard]] const ScreenFactors& findFactorsFromCoord(const QPointF& pos) const;
+
+    /// In a multiple monitor environment there are multiple screen resolutions, one set per monitor. This method
+    /// finds the screen containing the specified position and returns its conversion factors. The method does not
+    /// compensate for the location of the origin nor the orientation of the y-axis.
+    ///
+    /// @param[in] pos Position used to determine a screen, in the current units.
+    /// @return Conversion factors for the screen containing the position, or the factors for a zero resolution if
+    ///     the position is not on any screen.
     ///
-    [[nodiscard]] QSizeF findResFromPos(const QPointF& pos) const;
+    [[nodiscard]] const ScreenFactors& findFactorsFromPos(const QPointF& pos) const;
+
+    /// Recomputes the conversion factors for all screens.
+    ///
+    void updateScreenFactors() const;
+
+    /// Converts a coordinate from pixels to the current units, taking into account the location of the origin and
+    /// the orientation of the y-axis.
+    ///
+    [[nodiscard]] double toUnits(ConvertDir dir, const ScreenFactors& factors, int pos) const;
+
+    /// Converts a coordinate from the current units to pixels, taking into account the location of the origin and
+    /// the orientation of the y-axis. The coordinate is divided by the same factors used by toUnits so that
+    /// converting a coordinate to the units and back is exact.
+    ///
+    [[nodiscard]] double toPixels(ConvertDir dir, const ScreenFactors& factors, double pos) const;
 
-private:
     QPoint m_originOffset { 0, 0 };                 ///< Offset of the origin from the system origin, in pixels.
     bool m_invertY { false };                       ///< Indicates if the y-axis direction is inverted.
     const ScreenInfoProvider* m_screenInfoProvider; ///< Display screen information
     LinearUnitsId m_unitsId;                        ///< Linear units identifier.
+
+    /// Conversion factors for each screen, followed by the factors used for positions that are not on any screen.
+    mutable std::vector<ScreenFactors> m_screenFactors;
+    mutable int m_invertedOriginY { 0 };            ///< Origin y coordinate when the y-axis is inverted, in pixels.
+    mutable bool m_screenFactorsValid { false };    ///< Indicates if the conversion factors are up to date.
 };
 
 
@@ -168,6 +168,12 @@ bool UnitsMgr::isInvertY() const {
     return m_inchUnits.isInvertY();
 }
 
+void UnitsMgr::resolutionChanged() {
+    for (const auto& unitsEntry : m_linearUnitsMap) {
+        unitsEntry.second->invalidateScreenFactors();
+    }
+}
+
 void UnitsMgr::setAngularUnits(AngularUnitsId unitsId) {
     m_currentAngularUnits = (*m_angularUnitsMap.find(unitsId)).second;
 
@@ -195,31 +201,7 @@ bool UnitsMgr::isSupplementalAngle() const {
 }
 
 QSizeF UnitsMgr::getWidthHeight(const QPoint& p1, const QPoint& p2) const {
-    const int screenIndex1 = m_screenInfoProvider->screenForPoint(p1);
-    const QSizeF from1 = m_currentLinearUnits->fromPixels(m_screenInfoProvider->getScreenRes(screenIndex1));
-
-    const int screenIndex2 = m_screenInfoProvider->screenForPoint(p2);
-    const QSizeF from2 = m_currentLinearUnits->fromPixels(m_screenInfoProvider->getScreenRes(screenIndex2));
-
-    QPoint np1(p1);
-    QPoint np2(p2);
-
-    if (np1.x() < np2.x()) {
-        np2.rx()++;
-    } else {
-        np1.rx()++;
-    }
-
-    if (np1.y() < np2.y()) {
-        np2.ry()++;
-    } else {
-        np1.ry()++;
-    }
-
-    const QPointF cp1(from1.width() * np1.x(), from1.height() * np1.y());
-    const QPointF cp2(from2.width() * np2.x(), from2.height() * np2.y());
-
-    return { fabs(cp1.x() - cp2.x()), fabs(cp1.y() - cp2.y()) };
+    return m_currentLinearUnits->getWidthHeight(p1, p2);
 }
 
 QSizeF UnitsMgr::getMinorTickIncr(const QRect& rect) const {
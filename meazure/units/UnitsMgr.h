@@ -259,6 +259,14 @@ public:
         return m_currentLinearUnits->unconvertPos(pos);
     }
 
+    void convertCoords(const QPoint* pos, QPointF* coords, int count) const override {
+        m_currentLinearUnits->convertCoords(pos, coords, count);
+    }
+
+    void unconvertCoords(const QPointF* coords, QPoint* pos, int count) const override {
+        m_currentLinearUnits->unconvertCoords(coords, pos, count);
+    }
+
     [[nodiscard]] QSizeF convertRes(const QSizeF& res) const override {
         return m_currentLinearUnits->convertRes(res);
     }
@@ -311,6 +319,11 @@ public slots:
     ///
     void setSupplementalAngle(bool showSupplemental);
 
+    /// Called when the resolution of a display screen has changed (e.g. the screen has been calibrated) so that
+    /// the linear units recompute their conversion factors.
+    ///
+    void resolutionChanged();
+
 signals:
     void linearUnitsChanged(LinearUnitsId unitsId);
 
@@ -209,6 +209,26 @@ struct UnitsProvider {
     ///
     [[nodiscard]] virtual QPoint unconvertPos(const QPointF& pos) const = 0;
 
+    /// Converts the specified coordinates from pixels to the current units. The conversion takes into account the
+    /// location of the origin and the orientation of the y-axis. The result for each coordinate is identical to that
+    /// of convertCoord.
+    ///
+    /// @param[in] pos Coordinates in pixels to convert to the current units.
+    /// @param[out] coords Receives the converted coordinates. Must have room for count coordinates.
+    /// @param[in] count Number of coordinates to convert.
+    ///
+    virtual void convertCoords(const QPoint* pos, QPointF* coords, int count) const = 0;
+
+    /// Converts the specified coordinates from the current units to pixels. The conversion takes into account the
+    /// location of the origin and the orientation of the y-axis. The result for each coordinate is identical to that
+    /// of unconvertCoord(const QPointF&).
+    ///
+    /// @param[in] coords Coordinates to convert to pixels.
+    /// @param[out] pos Receives the converted coordinates. Must have room for count coordinates.
+    /// @param[in] count Number of coordinates to convert.
+    ///
+    virtual void unconvertCoords(const QPointF* coords, QPoint* pos, int count) const = 0;
+
     /// Converts the specified resolution in pixels/inch to the desired units.
     ///
     /// @param[in] res Resolution in pixels/inch to convert to the desired units.
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Cloaker.h"
+#include "TimedEventLoop.h"
+#include "PlatformUtils.h"
+#include "x11/XcbUtils.h"
+#include <meazure/graphics/Graphic.h>
+#include <QEventLoop>
+#include <QTimer>
+#include <cstdlib>
+
+
+bool Cloaker::isShown(const QWidget* widget) {
+    const auto* graphic = qobject_cast<const Graphic*>(widget);
+    return (graphic != nullptr) ? graphic->isShown() : !widget->isHidden();
+}
+
+void Cloaker::startTracking(ScreenDamageTracker* damageTracker, const QRect& area) {
+    if (damageTracker == nullptr || !damageTracker->isSupported()) {
+        return;
+    }
+
+    // Tracking starts before the widgets are hidden so that no damage caused by hiding them is missed.
+    damageTracker->setWatchRect(area);
+    damageTracker->start();
+    m_damageTracker = damageTracker;
+}
+
+void Cloaker::waitForRemoval() {
+    if (m_damageTracker == nullptr) {
+        const TimedEventLoop loop(k_processingTime);
+        return;
+    }
+
+    // Round trip to the X server on the Qt connection, so that the requests unmapping the widget windows have
+    // been processed before waiting for the screen to be repainted. Screen damage is only tracked on X11.
+    if (PlatformUtils::isX11()) {
+        xcb_connection_t* conn = Xcb::qtConnection();
+        std::free(xcb_get_input_focus_reply(conn, xcb_get_input_focus(conn), nullptr));  // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+    }
+
+    QEventLoop loop;
+
+    QTimer limitTimer;
+    limitTimer.setSingleShot(true);
+    connect(&limitTimer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+    // The screen is considered settled once no damage has been reported for the settle time after the first damage.
+    // The settle time only starts with the first damage, so the wait does not end before the screen has been
+    // repainted. If no damage is reported, the wait ends at the maximum wait time.
+    QTimer settleTimer;
+    settleTimer.setSingleShot(true);
+    settleTimer.setInterval(k_settleTime);
+    connect(&settleTimer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+    const QMetaObject::Connection damageConnection =
+            connect(dynamic_cast<QObject*>(m_damageTracker), SIGNAL(damaged()), &settleTimer, SLOT(start()));
+
+    limitTimer.start(k_maxWaitTime);
+    loop.exec();
+
+    disconnect(damageConnection);
+    m_damageTracker->stop();
+}
@@ -17,8 +17,10 @@
 
 #pragma once
 
-#include "TimedEventLoop.h"
+#include <meazure/environment/ScreenDamageTracker.h>
 #include <QWidget>
+#include <QRect>
+#include <QPoint>
 #include <vector>
 #include <utility>
 #include <cstdarg>
@@ -27,23 +29,49 @@
 /// Hides the wrapped widget during the scope of this object. When this object goes out of scope, the wrapped
 /// widget is restored to visibility if it was initially visible.
 ///
+/// Construction does not complete until the hidden widgets have been removed from the screen, so that the screen
+/// can be captured without them. If screen damage can be tracked, the screen area covered by the widgets is watched,
+/// and the wait ends once that area has been repainted and no further damage has been reported for a short settle
+/// time. This adapts to the speed of the compositor, rather than always waiting for a fixed time. The wait is capped
+/// at a maximum time, which is also how long it lasts if the area is never repainted. If nothing was visible, there
+/// is no wait at all. If screen damage cannot be tracked, a fixed delay is used.
+///
 class Cloaker : public QObject {
 
     Q_OBJECT
 
 public:
+    /// Hides the specified widgets.
+    ///
+    /// @param[in] damageTracker Used to wait for the widgets to be removed from the screen. The tracker must not be
+    ///     in use for any other purpose during the scope of this object.
+    /// @param[in] widgets Widgets to hide
+    ///
     template<class ... ARGS>
-    explicit Cloaker(ARGS ... widgets) {
+    explicit Cloaker(ScreenDamageTracker* damageTracker, ARGS ... widgets) {
         const std::initializer_list<QWidget*> params = { widgets... };
+        QRect area;
         for (QWidget* widget : params) {
-            const bool hidden = widget->isHidden();
+            const bool hidden = !isShown(widget);
             m_widgetStates.emplace_back(widget, hidden);
             if (!hidden) {
-                widget->hide();
+                area |= QRect(widget->mapToGlobal(QPoint(0, 0)), widget->size());
+            }
+        }
+
+        if (area.isEmpty()) {
+            return;
+        }
+
+        startTracking(damageTracker, area);
+
+        for (State state : m_widgetStates) {
+            if (!state.second) {
+                state.first->hide();
             }
         }
 
-        const TimedEventLoop loop(k_processingTime);
+        waitForRemoval();
     }
 
     ~Cloaker() override {
@@ -61,7 +89,29 @@ public:
 private:
     using State = std::pair<QWidget*, bool>;
 
-    static constexpr int k_processingTime = 100;   // Time to spend processing events, milliseconds
+    static constexpr int k_processingTime = 100;   // Time to spend processing events without damage tracking, ms
+    static constexpr int k_settleTime = 30;        // Time without further damage before the screen is settled, ms
+    static constexpr int k_maxWaitTime = 200;      // Longest time to wait for the screen to settle, ms
+
+    /// Indicates whether the specified widget is shown. Graphics drawn in the overlay are shown without their own
+    /// window being visible.
+    ///
+    /// @param[in] widget Widget to test
+    /// @return true if the widget is shown.
+    ///
+    static bool isShown(const QWidget* widget);
+
+    /// Starts watching the specified area of the screen for changes, if supported.
+    ///
+    /// @param[in] damageTracker Tracker used to watch the screen
+    /// @param[in] area Area of the screen covered by the widgets to be hidden, in global coordinates
+    ///
+    void startTracking(ScreenDamageTracker* damageTracker, const QRect& area);
+
+    /// Waits for the hidden widgets to be removed from the screen, while processing events.
+    ///
+    void waitForRemoval();
 
     std::vector<State> m_widgetStates;
+    ScreenDamageTracker* m_damageTracker { nullptr };
 };
@@ -24,9 +24,11 @@
 #include <QtMath>
 #include <QTransform>
 #include <vector>
+#include <algorithm>
 #include <cstddef>
 #include <cmath>
 #include <limits>
+#include <utility>
 
 
 /// Convenience methods for calculating various geometric values (e.g. area, circumference, angle).
@@ -439,6 +441,207 @@ namespace Geometry {
         return (closestRectIndex == -1) ? point : constrain(rects[closestRectIndex], point);
     }
 
+    /// Spatial index of rectangles ordered by z-order, from the topmost rectangle at index 0 to the bottommost
+    /// rectangle. The bounding box of the rectangles is divided into a uniform grid of cells, and each cell lists
+    /// the rectangles overlapping it in z-order. A point query therefore only tests the rectangles in one cell, and
+    /// stops at the first (i.e. topmost) containing rectangle. The grid is sized so that a cell holds a few
+    /// rectangles on average. The index is immutable once built. Rebuild it when the rectangles change.
+    ///
+    class RectIndex {
+
+    public:
+        RectIndex() = default;
+
+        /// Builds an index of the specified rectangles.
+        ///
+        /// @param[in] rects Rectangles to index, from the top of the z-order to the bottom
+        ///
+        explicit RectIndex(std::vector<QRect> rects) {
+            build(std::move(rects));
+        }
+
+        /// Builds an index of the specified rectangles.
+        ///
+        /// @tparam RECT Type derived from QRect
+        /// @param[in] rects Rectangles to index, from the top of the z-order to the bottom
+        ///
+        template<class RECT>
+        explicit RectIndex(const std::vector<RECT*>& rects) {
+            std::vector<QRect> copy;
+            copy.reserve(rects.size());
+            for (const RECT* rect : rects) {
+                copy.push_back(*rect);
+            }
+            build(std::move(copy));
+        }
+
+        /// Replaces the indexed rectangles.
+        ///
+        /// @param[in] rects Rectangles to index, from the top of the z-order to the bottom
+        ///
+        void build(std::vector<QRect> rects) {
+            m_rects = std::move(rects);
+            m_bounds = QRect();
+            m_cellStarts.clear();
+            m_cellRects.clear();
+
+            int count = 0;
+            for (const QRect& rect : m_rects) {
+                if (!rect.isEmpty()) {
+                    m_bounds = m_bounds.united(rect);
+                    count++;
+                }
+            }
+            if (count == 0) {
+                return;
+            }
+
+            // Aim for a grid with about as many cells as rectangles, up to a limit.
+            const int divisions = std::clamp(static_cast<int>(std::ceil(std::sqrt(count))), 1, k_maxDivisions);
+            m_columns = std::min(divisions, m_bounds.width());
+            m_rows = std::min(divisions, m_bounds.height());
+            m_cellWidth = (m_bounds.width() + m_columns - 1) / m_columns;
+            m_cellHeight = (m_bounds.height() + m_rows - 1) / m_rows;
+
+            // The cell lists are stored contiguously. Count the rectangles in each cell, convert the counts to
+            // starting offsets, then fill in the rectangles in z-order.
+            const auto numCells = static_cast<std::size_t>(m_columns * m_rows);
+            m_cellStarts.assign(numCells + 1, 0);
+            forEachCell([this](const QRect&, std::size_t cell, int) { m_cellStarts[cell + 1]++; });
+            for (std::size_t cell = 0; cell < numCells; cell++) {
+                m_cellStarts[cell + 1] += m_cellStarts[cell];
+            }
+
+            std::vector<int> fill(m_cellStarts.begin(), m_cellStarts.end() - 1);
+            m_cellRects.resize(static_cast<std::size_t>(m_cellStarts[numCells]));
+            forEachCell([this, &fill](const QRect&, std::size_t cell, int index) {
+                m_cellRects[static_cast<std::size_t>(fill[cell]++)] = index;
+            });
+        }
+
+        /// Obtains the number of indexed rectangles.
+        ///
+        /// @return Number of rectangles, including any empty rectangles.
+        ///
+        [[nodiscard]] int size() const {
+            return static_cast<int>(m_rects.size());
+        }
+
+        /// Obtains the specified rectangle.
+        ///
+        /// @param[in] index Index of the rectangle in z-order. Must be a valid index.
+        /// @return Rectangle at the specified index.
+        ///
+        [[nodiscard]] const QRect& at(int index) const {
+            return m_rects.at(static_cast<std::size_t>(index));
+        }
+
+        /// Finds the topmost rectangle containing the specified point. Equivalent to the contains function for a
+        /// list of rectangles.
+        ///
+        /// @param[in] point Point to test
+        /// @return Index of the topmost rectangle containing the point, or -1 if the point is not contained in any
+        ///     rectangle.
+        ///
+        [[nodiscard]] int find(const QPoint& point) const {
+            if (!m_bounds.contains(point, false)) {
+                return -1;
+            }
+
+            const std::size_t cell = cellIndex((point.x() - m_bounds.left()) / m_cellWidth,
+                                               (point.y() - m_bounds.top()) / m_cellHeight);
+            const auto end = static_cast<std::size_t>(m_cellStarts[cell + 1]);
+            for (auto i = static_cast<std::size_t>(m_cellStarts[cell]); i < end; i++) {
+                const int index = m_cellRects[i];
+                if (m_rects[static_cast<std::size_t>(index)].contains(point, false)) {
+                    return index;
+                }
+            }
+
+            return -1;
+        }
+
+        /// Finds the rectangle with the largest intersection with the specified rectangle. Equivalent to the
+        /// contains function for a list of rectangles.
+        ///
+        /// @param[in] rect Rectangle to test
+        /// @return Index of the rectangle with the largest intersection area. If several rectangles have the same
+        ///     intersection area, the topmost is returned. Returns -1 if the rectangle does not intersect any
+        ///     rectangle.
+        ///
+        [[nodiscard]] int findBestOverlap(const QRect& rect) const {
+            const QRect clipped = m_bounds.intersected(rect);
+            if (clipped.isEmpty()) {
+                return -1;
+            }
+
+            int maxArea = 0;
+            int bestIndex = -1;
+
+            // A rectangle spanning several cells is tested once per cell. The result is unaffected.
+            const int col0 = (clipped.left() - m_bounds.left()) / m_cellWidth;
+            const int col1 = (clipped.right() - m_bounds.left()) / m_cellWidth;
+            const int row0 = (clipped.top() - m_bounds.top()) / m_cellHeight;
+            const int row1 = (clipped.bottom() - m_bounds.top()) / m_cellHeight;
+            for (int row = row0; row <= row1; row++) {
+                for (int col = col0; col <= col1; col++) {
+                    const std::size_t cell = cellIndex(col, row);
+                    const auto end = static_cast<std::size_t>(m_cellStarts[cell + 1]);
+                    for (auto i = static_cast<std::size_t>(m_cellStarts[cell]); i < end; i++) {
+                        const int index = m_cellRects[i];
+                        const int intersectionArea = area(m_rects[static_cast<std::size_t>(index)].intersected(rect));
+                        if (intersectionArea > maxArea || (intersectionArea == maxArea && intersectionArea > 0
+                                                           && index < bestIndex)) {
+                            maxArea = intersectionArea;
+                            bestIndex = index;
+                        }
+                    }
+                }
+            }
+
+            return bestIndex;
+        }
+
+    private:
+        static constexpr int k_maxDivisions { 32 };     ///< Maximum number of cells along each axis
+
+        [[nodiscard]] std::size_t cellIndex(int col, int row) const {
+            return static_cast<std::size_t>(row * m_columns + col);
+        }
+
+        /// Calls the specified function for each cell overlapped by each non-empty rectangle, in z-order.
+        ///
+        template<class FUNC>
+        void forEachCell(FUNC func) const {
+            const int count = size();
+            for (int index = 0; index < count; index++) {
+                const QRect& rect = m_rects[static_cast<std::size_t>(index)];
+                if (rect.isEmpty()) {
+                    continue;
+                }
+
+                const int col0 = (rect.left() - m_bounds.left()) / m_cellWidth;
+                const int col1 = (rect.right() - m_bounds.left()) / m_cellWidth;
+                const int row0 = (rect.top() - m_bounds.top()) / m_cellHeight;
+                const int row1 = (rect.bottom() - m_bounds.top()) / m_cellHeight;
+                for (int row = row0; row <= row1; row++) {
+                    for (int col = col0; col <= col1; col++) {
+                        func(rect, cellIndex(col, row), index);
+                    }
+                }
+            }
+        }
+
+        std::vector<QRect> m_rects;
+        QRect m_bounds;                     ///< Bounding box of the non-empty rectangles
+        int m_columns { 0 };
+        int m_rows { 0 };
+        int m_cellWidth { 1 };
+        int m_cellHeight { 1 };
+        std::vector<int> m_cellStarts;      ///< Offset in m_cellRects of the list for each cell, plus the end offset
+        std::vector<int> m_cellRects;       ///< Rectangle indices for each cell, in z-order
+    };
+
     /// Creates a transform that performs a rotation by the specified angle around the specified point.
     ///
     /// @param angle Rotation angle in degrees
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RefreshPacer.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <algorithm>
+
+
+RefreshPacer::RefreshPacer(QObject* parent) : QObject(parent) {
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &RefreshPacer::trigger);
+
+    updateInterval();
+}
+
+void RefreshPacer::updateInterval() {
+    const QScreen* screen = QGuiApplication::primaryScreen();
+    const int refreshRate = (screen != nullptr && screen->refreshRate() >= 1.0) ? qRound(screen->refreshRate())
+                                                                                : k_defRefreshRate;
+    setRefreshRate(refreshRate);
+}
+
+void RefreshPacer::setRefreshRate(int rate) {
+    m_interval = 1000 / rate;
+}
+
+void RefreshPacer::schedule() {
+    if (m_timer.isActive()) {
+        return;
+    }
+
+    const qint64 elapsed = m_lastTriggerTime.isValid() ? m_lastTriggerTime.elapsed() : m_interval;
+    m_timer.start(static_cast<int>(std::max<qint64>(m_interval - elapsed, 0)));
+}
+
+void RefreshPacer::stop() {
+    m_timer.stop();
+}
+
+void RefreshPacer::markPerformed() {
+    m_timer.stop();
+    m_lastTriggerTime.start();
+}
+
+void RefreshPacer::trigger() {
+    m_lastTriggerTime.start();
+    emit triggered();
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+
+/// Paces an action (e.g. painting or reporting a position) to the display refresh or to a specified rate. An action
+/// requested after a pause is triggered as soon as control returns to the event loop. Requests made while an action
+/// is pending are combined, and requests made during continuous activity are delayed to the end of the refresh
+/// interval, so the action is triggered at most once per refresh interval.
+///
+class RefreshPacer : public QObject {
+
+    Q_OBJECT
+
+public:
+    explicit RefreshPacer(QObject* parent = nullptr);
+
+    /// Reads the refresh rate of the primary display. The rate is read when the pacer is constructed. Call this
+    /// method to pick up a change in the display (e.g. when starting to track the display).
+    ///
+    void updateInterval();
+
+    /// Paces the action to the specified rate rather than to the display refresh rate.
+    ///
+    /// @param[in] rate Maximum rate at which the action is triggered, in Hertz. Must be greater than 0.
+    ///
+    void setRefreshRate(int rate);
+
+    /// Obtains the interval between triggers.
+    ///
+    /// @return Refresh interval, in milliseconds.
+    ///
+    [[nodiscard]] int getInterval() const {
+        return m_interval;
+    }
+
+    /// Requests that the action be triggered. Has no effect if the action is already scheduled.
+    ///
+    void schedule();
+
+    /// Indicates whether the action is scheduled but has not yet been triggered.
+    ///
+    /// @return true if the action is scheduled.
+    ///
+    [[nodiscard]] bool isScheduled() const {
+        return m_timer.isActive();
+    }
+
+    /// Cancels any scheduled trigger.
+    ///
+    void stop();
+
+    /// Records that the action has been performed without being triggered by the pacer (e.g. flushed on demand).
+    /// Any scheduled trigger is cancelled and the next trigger is paced from now.
+    ///
+    void markPerformed();
+
+signals:
+    /// Emitted when the action should be performed.
+    ///
+    void triggered();
+
+private:
+    static constexpr int k_defRefreshRate { 60 };       // Used if the display refresh rate is not known, Hertz
+
+    void trigger();
+
+    QTimer m_timer;                     ///< Delays the action to the end of the refresh interval
+    QElapsedTimer m_lastTriggerTime;
+    int m_interval { 1000 / k_defRefreshRate };         // Milliseconds
+};
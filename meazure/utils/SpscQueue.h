@@ -0,0 +1,101 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+
+/// A bounded, lock-free queue for passing values from exactly one producer thread to exactly one consumer thread.
+/// Neither thread ever blocks the other. The producer only writes the tail index and the consumer only writes the
+/// head index, so the indices are kept on separate cache lines to avoid false sharing between the threads.
+///
+/// @tparam T Type of the queued values. Must be default constructible and copy assignable.
+/// @tparam CAPACITY Maximum number of values in the queue. Must be a power of 2.
+///
+template <typename T, std::size_t CAPACITY>
+class SpscQueue {
+
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of 2");
+
+public:
+    /// Adds a value to the end of the queue. Only call this method from the producer thread.
+    ///
+    /// @param[in] value Value to add
+    /// @return true if the value was added. false if the queue is full.
+    ///
+    bool push(const T& value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == CAPACITY) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == CAPACITY) {
+                return false;
+            }
+        }
+
+        m_values[tail & (CAPACITY - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Removes the value at the front of the queue. Only call this method from the consumer thread.
+    ///
+    /// @param[out] value Receives the removed value
+    /// @return true if a value was removed. false if the queue is empty.
+    ///
+    bool pop(T& value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+
+        value = m_values[head & (CAPACITY - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Indicates whether the queue is empty. Only call this method from the consumer thread.
+    ///
+    /// @return true if there are no values in the queue.
+    ///
+    [[nodiscard]] bool isEmpty() const {
+        return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_acquire);
+    }
+
+    /// Removes all values from the queue. Only call this method from the consumer thread.
+    ///
+    void clear() {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        m_head.store(m_cachedTail, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::size_t k_cacheLineSize { 64 };
+
+    std::array<T, CAPACITY> m_values {};
+
+    alignas(k_cacheLineSize) std::atomic<std::size_t> m_head { 0 };     ///< Next value to pop, written by consumer
+    std::size_t m_cachedTail { 0 };                                     ///< Consumer's copy of the tail
+
+    alignas(k_cacheLineSize) std::atomic<std::size_t> m_tail { 0 };     ///< Next slot to push, written by producer
+    std::size_t m_cachedHead { 0 };                                     ///< Producer's copy of the head
+};
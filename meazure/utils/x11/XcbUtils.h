@@ -21,6 +21,7 @@
 #include <QString>
 #include <QGuiApplication>
 #include <xcb/xcb.h>
+#include <xcb/shm.h>
 #include <memory>
 #include <cstring>
 #include <cstdlib>
@@ -96,7 +97,8 @@ namespace Xcb {
         using ReplyFunc = REPLY* (*)(xcb_connection_t* conn, COOKIE cookie, xcb_generic_error_t **err);
 
         explicit Base(xcb_connection_t* connection, const COOKIE& cookie, const ReplyFunc& replyFunc) :
-                m_connection(connection), m_cookie(cookie), m_replyFunc(replyFunc) {
+                m_connection(connection), m_cookie(cookie), m_replyFunc(replyFunc),
+                m_pending(std::make_shared<PendingReply>(connection, cookie.sequence)) {
         }
 
         /// Performs the lazy call to the reply function.
@@ -109,6 +111,7 @@ namespace Xcb {
             if (!m_reply) {
                 xcb_generic_error_t* error = nullptr;
                 m_reply = ReplyPtr(m_replyFunc(m_connection, m_cookie, &error), std::free);
+                m_pending->read = true;
                 if (error != nullptr) {
                     const int errorCode = error->error_code;
                     std::free(error);       // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
@@ -120,10 +123,36 @@ namespace Xcb {
         }
 
 
+        /// Discards the reply to a request if the reply is never read. Otherwise, the reply remains queued in the
+        /// connection (e.g. when a request is abandoned because an earlier request in a pipeline failed). Shared by
+        /// copies of a wrapper so that the reply is discarded once, when the last copy is destroyed.
+        ///
+        struct PendingReply {
+            PendingReply(xcb_connection_t* conn, unsigned int seq) : connection(conn), sequence(seq) {
+            }
+
+            ~PendingReply() {
+                if (!read) {
+                    xcb_discard_reply(connection, sequence);
+                }
+            }
+
+            PendingReply(const PendingReply&) = delete;
+            PendingReply(PendingReply&&) = delete;
+            PendingReply& operator=(const PendingReply&) = delete;
+            PendingReply& operator=(PendingReply&&) = delete;
+
+            xcb_connection_t* connection;
+            unsigned int sequence;
+            bool read { false };
+        };
+
+
         xcb_connection_t* m_connection;
         COOKIE m_cookie;
         ReplyFunc m_replyFunc;
         ReplyPtr m_reply;
+        std::shared_ptr<PendingReply> m_pending;
     };
 
 
@@ -273,4 +302,47 @@ namespace Xcb {
             return xcb_get_property_value_length(get().get());
         }
     };
+
+
+    /// Represents the version of the MIT Shared Memory (MIT-SHM) extension supported by the X server.
+    ///
+    class ShmQueryVersion : public Base<xcb_shm_query_version_cookie_t, xcb_shm_query_version_reply_t> {
+    public:
+        /// Queries the version of the shared memory extension. The reply function reports an error if the extension
+        /// is not present on the X server.
+        ///
+        /// @param[in] connection Connection to the X server
+        ///
+        explicit ShmQueryVersion(xcb_connection_t* connection) :
+                Base(connection,
+                     xcb_shm_query_version(connection),
+                     xcb_shm_query_version_reply) {
+        }
+    };
+
+
+    /// Represents the contents of a rectangle of a drawable copied into a shared memory segment.
+    ///
+    class ShmGetImage : public Base<xcb_shm_get_image_cookie_t, xcb_shm_get_image_reply_t> {
+    public:
+        /// Copies the contents of the specified rectangle of a drawable into a shared memory segment that has been
+        /// attached to the X server. The pixels are written in Z pixmap format starting at the specified offset.
+        ///
+        /// @param[in] connection Connection to the X server
+        /// @param[in] drawable Drawable whose contents are to be obtained (e.g. root window)
+        /// @param[in] x Left side of the rectangle relative to the drawable origin
+        /// @param[in] y Top of the rectangle relative to the drawable origin
+        /// @param[in] width Width of the rectangle
+        /// @param[in] height Height of the rectangle
+        /// @param[in] segment Shared memory segment attached to the X server
+        /// @param[in] offset Byte offset into the segment at which the image is written
+        ///
+        ShmGetImage(xcb_connection_t* connection, xcb_drawable_t drawable, int16_t x, int16_t y,
+                    uint16_t width, uint16_t height, xcb_shm_seg_t segment, uint32_t offset) :
+                Base(connection,
+                     xcb_shm_get_image(connection, drawable, x, y, width, height, ~0U, XCB_IMAGE_FORMAT_Z_PIXMAP,
+                                       segment, offset),
+                     xcb_shm_get_image_reply) {
+        }
+    };
 }
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <QTest>
+#include <QtPlugin>
+#include <QApplication>
+#include <meazure/environment/x11/X11WindowFinder.h>
+#include <meazure/utils/x11/XcbUtils.h>
+#include <meazure/utils/PlatformUtils.h>
+#include <QRect>
+#include <QPoint>
+#include <vector>
+#include <array>
+#include <cstdlib>
+
+
+Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+Q_IMPORT_PLUGIN(QSvgIconPlugin)
+
+
+/// Tests and benchmarks the X11 window finder against synthetic top level windows. Because there is no window manager,
+/// this test is best run on an otherwise empty X server (e.g. using xvfb-run). Half of the windows are given WM_STATE
+/// directly, as unmanaged top level windows would be. The other half place the client window two levels down inside
+/// frame windows, as a reparenting window manager would.
+///
+class X11WindowFinderTest : public QObject {
+
+Q_OBJECT
+
+private slots:
+    [[maybe_unused]] void initTestCase();
+    [[maybe_unused]] void cleanupTestCase();
+    [[maybe_unused]] void testFind();
+    [[maybe_unused]] void testFindAfterEvents();
+    [[maybe_unused]] void testFindDepthFirst();
+    [[maybe_unused]] void benchmarkScan();
+
+private:
+    static constexpr int k_numWindows { 300 };
+    static constexpr int k_clientOffset { 5 };      // Location of the client window within its frame
+
+    xcb_window_t createWindow(xcb_window_t parent, const QRect& rect);
+    void setWMState(xcb_window_t window);
+    void sync();
+
+    xcb_connection_t* m_conn { nullptr };
+    xcb_window_t m_root { XCB_WINDOW_NONE };
+    std::vector<xcb_window_t> m_topWindows;
+    std::vector<QRect> m_clientRects;
+};
+
+
+[[maybe_unused]] void X11WindowFinderTest::initTestCase() {
+    if (!PlatformUtils::isX11()) {
+        QSKIP("The window finder requires an X server");
+    }
+
+    m_conn = Xcb::qtConnection();
+    m_root = xcb_setup_roots_iterator(xcb_get_setup(m_conn)).data->root;
+
+    for (int i = 0; i < k_numWindows; i++) {
+        const QRect rect((i % 20) * 30, (i / 20) * 30, 200, 150);
+
+        if (i % 2 == 0) {
+            const xcb_window_t window = createWindow(m_root, rect);
+            setWMState(window);
+            m_topWindows.push_back(window);
+            m_clientRects.push_back(rect);
+        } else {
+            const xcb_window_t frame = createWindow(m_root, rect);
+            const QRect innerRect(0, 0, rect.width(), rect.height());
+            const xcb_window_t inner = createWindow(frame, innerRect);
+            const QRect clientRect(k_clientOffset, k_clientOffset, rect.width() - 2 * k_clientOffset,
+                                   rect.height() - 2 * k_clientOffset);
+            const xcb_window_t client = createWindow(inner, clientRect);
+            setWMState(client);
+            m_topWindows.push_back(frame);
+            m_clientRects.push_back(clientRect.translated(rect.topLeft()));
+        }
+    }
+
+    sync();
+}
+
+[[maybe_unused]] void X11WindowFinderTest::cleanupTestCase() {
+    for (const xcb_window_t window : m_topWindows) {
+        xcb_destroy_window(m_conn, window);
+    }
+    if (m_conn != nullptr) {
+        sync();
+    }
+}
+
+[[maybe_unused]] void X11WindowFinderTest::testFind() {
+    X11WindowFinder finder;
+    finder.refresh();
+
+    // The most recently created window is at the top of the stack.
+    const QRect& topRect = m_clientRects.back();
+    QCOMPARE(finder.find(topRect.center()), topRect);
+
+    const QRect& bottomRect = m_clientRects.front();
+    QCOMPARE(finder.find(bottomRect.topLeft()), bottomRect);
+}
+
+[[maybe_unused]] void X11WindowFinderTest::testFindAfterEvents() {
+    X11WindowFinder finder;
+    finder.refresh();
+
+    // Raise the bottom window and move it.
+    const xcb_window_t bottom = m_topWindows.front();
+    const QRect movedRect = m_clientRects.front().translated(7, 9);
+    const std::array<uint32_t, 3> values { static_cast<uint32_t>(movedRect.x()), static_cast<uint32_t>(movedRect.y()),
+                                           XCB_STACK_MODE_ABOVE };
+    xcb_configure_window(m_conn, bottom, XCB_CONFIG_WINDOW_X | XCB_CONFIG_WINDOW_Y | XCB_CONFIG_WINDOW_STACK_MODE,
+                         values.data());
+    sync();
+
+    WindowEvent event;
+    event.type = WindowEvent::Configured;
+    event.window = bottom;
+    event.sibling = m_topWindows.back();
+    event.x = static_cast<int16_t>(movedRect.x());
+    event.y = static_cast<int16_t>(movedRect.y());
+    event.width = static_cast<uint16_t>(movedRect.width());
+    event.height = static_cast<uint16_t>(movedRect.height());
+    finder.update(event);
+
+    const QPoint position = movedRect.center();
+    QCOMPARE(finder.find(position), movedRect);
+
+    // Unmapping the window reveals the topmost of the other windows at the position.
+    xcb_unmap_window(m_conn, bottom);
+    sync();
+
+    event = WindowEvent();
+    event.type = WindowEvent::Unmapped;
+    event.window = bottom;
+    finder.update(event);
+
+    QRect expectedRect;
+    for (auto iter = m_clientRects.rbegin(); iter != m_clientRects.rend() - 1; ++iter) {
+        if (iter->contains(position)) {
+            expectedRect = *iter;
+            break;
+        }
+    }
+    QCOMPARE(finder.find(position), expectedRect);
+
+    // Restore the window.
+    const std::array<uint32_t, 3> restore { static_cast<uint32_t>(m_clientRects.front().x()),
+                                            static_cast<uint32_t>(m_clientRects.front().y()),
+                                            XCB_STACK_MODE_BELOW };
+    xcb_configure_window(m_conn, bottom, XCB_CONFIG_WINDOW_X | XCB_CONFIG_WINDOW_Y | XCB_CONFIG_WINDOW_STACK_MODE,
+                         restore.data());
+    xcb_map_window(m_conn, bottom);
+    sync();
+}
+
+[[maybe_unused]] void X11WindowFinderTest::testFindDepthFirst() {
+    // A frame, away from the other windows, containing a client two levels down followed by a client directly
+    // within the frame. As with a depth first search, the deeper client is found because it comes first.
+    const QRect frameRect(900, 100, 200, 150);
+    const xcb_window_t frame = createWindow(m_root, frameRect);
+    const xcb_window_t inner = createWindow(frame, QRect(0, 0, frameRect.width(), frameRect.height()));
+    const QRect clientRect(k_clientOffset, k_clientOffset, frameRect.width() - 2 * k_clientOffset,
+                           frameRect.height() - 2 * k_clientOffset);
+    setWMState(createWindow(inner, clientRect));
+    setWMState(createWindow(frame, QRect(20, 20, 50, 50)));
+    sync();
+
+    X11WindowFinder finder;
+    finder.refresh();
+
+    const QRect expectedRect = clientRect.translated(frameRect.topLeft());
+    QCOMPARE(finder.find(expectedRect.center()), expectedRect);
+
+    xcb_destroy_window(m_conn, frame);
+    sync();
+}
+
+[[maybe_unused]] void X11WindowFinderTest::benchmarkScan() {
+    X11WindowFinder finder;
+    const QPoint position = m_clientRects.front().topLeft();
+
+    QBENCHMARK {
+        finder.refresh();
+        finder.find(position);
+    }
+}
+
+xcb_window_t X11WindowFinderTest::createWindow(xcb_window_t parent, const QRect& rect) {
+    const xcb_window_t window = xcb_generate_id(m_conn);
+    xcb_create_window(m_conn, XCB_COPY_FROM_PARENT, window, parent,
+                      static_cast<int16_t>(rect.x()), static_cast<int16_t>(rect.y()),
+                      static_cast<uint16_t>(rect.width()), static_cast<uint16_t>(rect.height()), 0,
+                      XCB_WINDOW_CLASS_INPUT_OUTPUT, XCB_COPY_FROM_PARENT, 0, nullptr);
+    xcb_map_window(m_conn, window);
+    return window;
+}
+
+void X11WindowFinderTest::setWMState(xcb_window_t window) {
+    Xcb::Atom wmState(m_conn, false, "WM_STATE");
+    const std::array<uint32_t, 2> state { 1, XCB_WINDOW_NONE };     // NormalState, no icon window
+    xcb_change_property(m_conn, XCB_PROP_MODE_REPLACE, window, wmState, wmState, 32,
+                        static_cast<uint32_t>(state.size()), state.data());
+}
+
+void X11WindowFinderTest::sync() {
+    // A round trip ensures that all requests have been processed by the server.
+    xcb_get_input_focus_reply_t* reply = xcb_get_input_focus_reply(m_conn, xcb_get_input_focus(m_conn), nullptr);
+    std::free(reply);       // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+}
+
+// The test application uses the statically linked xcb platform plugin, which aborts when there is no X server.
+// Therefore, check for an X server before creating the application, and report the test as skipped if there is none.
+// The skip return code is registered with CTest in the test CMakeLists.txt file.
+int main(int argc, char* argv[]) {
+    static constexpr int skipReturnCode = 77;
+
+    xcb_connection_t* conn = xcb_connect(nullptr, nullptr);
+    const bool haveServer = (xcb_connection_has_error(conn) == 0);
+    xcb_disconnect(conn);
+    if (!haveServer) {
+        qInfo("SKIP: The window finder requires an X server");
+        return skipReturnCode;
+    }
+
+    QApplication app(argc, argv);
+    app.setAttribute(Qt::AA_Use96Dpi, true);
+    X11WindowFinderTest test;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "X11WindowFinderTest.moc"
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QtPlugin>
+#include <meazure/graphics/PixelZoom.h>
+#include <meazure/ui/Magnifier.h>
+#include <QImage>
+#include <QPainter>
+#include <QTransform>
+#include <QRandomGenerator>
+#include <vector>
+#include <algorithm>
+
+
+Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+Q_IMPORT_PLUGIN(QSvgIconPlugin)
+
+
+class PixelZoomTest : public QObject {
+
+Q_OBJECT
+
+private slots:
+    [[maybe_unused]] void testZoom_data();
+    [[maybe_unused]] void testZoom();
+    [[maybe_unused]] void testZoomClipped();
+    [[maybe_unused]] void testZoomEmptySource();
+    [[maybe_unused]] void benchmarkPixelZoom_data();
+    [[maybe_unused]] void benchmarkPixelZoom();
+    [[maybe_unused]] void benchmarkPainter_data();
+    [[maybe_unused]] void benchmarkPainter();
+
+private:
+    static constexpr int k_size { 281 };        // Same as the magnifier
+    static constexpr QRgb k_gridColor { qRgb(0, 0, 0) };
+    static constexpr QRgb k_markerColor { qRgb(255, 0, 0) };
+
+    /// Everything needed to draw the magnifier at a given zoom factor, laid out the same way as the magnifier.
+    ///
+    struct Scene {
+        QImage source;
+        int factor;
+        QPoint origin;
+        QRect marker;
+        std::vector<QLine> gridLines;
+    };
+
+    static void addZoomFactors();
+    static Scene createScene(int factor);
+    static void paintWithPainter(const Scene& scene, QImage& target);
+    static void paintWithPixelZoom(const Scene& scene, QImage& target);
+};
+
+
+void PixelZoomTest::addZoomFactors() {
+    QTest::addColumn<int>("factor");
+
+    for (const int factor : Magnifier::getZoomFactors()) {
+        QTest::addRow("%dx", factor) << factor;
+    }
+}
+
+PixelZoomTest::Scene PixelZoomTest::createScene(int factor) {
+    Scene scene;
+    scene.factor = factor;
+
+    const int markerCoord = (k_size - factor) / 2;
+    scene.marker = QRect(markerCoord, markerCoord, factor, factor);
+
+    const int half = (markerCoord + factor - 1) / factor + 1;
+    const int sourceSize = std::min(2 * half + 1, k_size);
+    scene.origin = QPoint(markerCoord - factor * (sourceSize / 2), markerCoord - factor * (sourceSize / 2));
+
+    QRandomGenerator random(factor);
+    scene.source = QImage(sourceSize, sourceSize, QImage::Format_RGB32);
+    for (int y = 0; y < sourceSize; y++) {
+        for (int x = 0; x < sourceSize; x++) {
+            scene.source.setPixel(x, y, random.generate() | 0xFF000000);
+        }
+    }
+
+    for (int c = markerCoord; c > 0; c -= factor) {
+        scene.gridLines.emplace_back(c, 0, c, k_size - 1);
+        scene.gridLines.emplace_back(0, c, k_size - 1, c);
+    }
+    for (int c = markerCoord + factor; c < k_size; c += factor) {
+        scene.gridLines.emplace_back(c, 0, c, k_size - 1);
+        scene.gridLines.emplace_back(0, c, k_size - 1, c);
+    }
+
+    return scene;
+}
+
+void PixelZoomTest::paintWithPainter(const Scene& scene, QImage& target) {
+    target.fill(Qt::black);
+
+    QPainter painter(&target);
+    painter.save();
+    painter.setTransform(QTransform::fromTranslate(scene.origin.x(), scene.origin.y()).scale(scene.factor,
+                                                                                             scene.factor));
+    painter.drawImage(0, 0, scene.source);
+    painter.restore();
+
+    painter.setPen(QPen(QBrush(QColor(k_gridColor)), 1));
+    painter.drawLines(scene.gridLines.data(), static_cast<int>(scene.gridLines.size()));
+
+    painter.setPen(QPen(QBrush(QColor(k_markerColor)), 1));
+    painter.drawRect(scene.marker);
+}
+
+void PixelZoomTest::paintWithPixelZoom(const Scene& scene, QImage& target) {
+    PixelZoom::Overlay overlay;
+    overlay.lines = scene.gridLines.data();
+    overlay.lineCount = static_cast<int>(scene.gridLines.size());
+    overlay.lineColor = k_gridColor;
+    overlay.marker = scene.marker;
+    overlay.markerColor = k_markerColor;
+
+    PixelZoom::zoom(scene.source, scene.source.rect(), scene.factor, scene.origin, target, overlay);
+}
+
+[[maybe_unused]] void PixelZoomTest::testZoom_data() {
+    addZoomFactors();
+}
+
+[[maybe_unused]] void PixelZoomTest::testZoom() {
+    QFETCH(int, factor);
+
+    const Scene scene = createScene(factor);
+    QImage zoomed(k_size, k_size, QImage::Format_RGB32);
+    QImage painted(k_size, k_size, QImage::Format_RGB32);
+    paintWithPixelZoom(scene, zoomed);
+    paintWithPainter(scene, painted);
+
+    QCOMPARE(zoomed, painted);
+}
+
+[[maybe_unused]] void PixelZoomTest::testZoomClipped() {
+    QImage source(3, 2, QImage::Format_RGB32);
+    source.setPixel(0, 0, qRgb(1, 0, 0));
+    source.setPixel(1, 0, qRgb(2, 0, 0));
+    source.setPixel(2, 0, qRgb(3, 0, 0));
+    source.setPixel(0, 1, qRgb(4, 0, 0));
+    source.setPixel(1, 1, qRgb(5, 0, 0));
+    source.setPixel(2, 1, qRgb(6, 0, 0));
+
+    // The first source column is partially off the left edge and the last source column is partially off the
+    // right edge of the target. The source only covers the first four rows of the target.
+    QImage target(6, 6, QImage::Format_RGB32);
+    target.fill(Qt::white);
+    PixelZoom::zoom(source, source.rect(), 2, QPoint(-1, 0), target);
+
+    const QRgb black = qRgb(0, 0, 0);
+    const std::vector<QRgb> expectedRows[] = {
+        { qRgb(1, 0, 0), qRgb(2, 0, 0), qRgb(2, 0, 0), qRgb(3, 0, 0), qRgb(3, 0, 0), black },
+        { qRgb(4, 0, 0), qRgb(5, 0, 0), qRgb(5, 0, 0), qRgb(6, 0, 0), qRgb(6, 0, 0), black },
+    };
+    for (int y = 0; y < target.height(); y++) {
+        for (int x = 0; x < target.width(); x++) {
+            const QRgb expected = (y < 4) ? expectedRows[y / 2][static_cast<std::size_t>(x)] : black;
+            QCOMPARE(target.pixel(x, y), expected);
+        }
+    }
+}
+
+[[maybe_unused]] void PixelZoomTest::testZoomEmptySource() {
+    const QImage source(10, 10, QImage::Format_RGB32);
+    QImage target(8, 8, QImage::Format_RGB32);
+    target.fill(Qt::white);
+
+    PixelZoom::Overlay overlay;
+    overlay.marker = QRect(2, 2, 3, 3);
+    overlay.markerColor = k_markerColor;
+
+    PixelZoom::zoom(source, QRect(), 4, QPoint(0, 0), target, overlay);
+
+    for (int y = 0; y < target.height(); y++) {
+        for (int x = 0; x < target.width(); x++) {
+            const bool onMarker = (x >= 2 && x <= 5 && y >= 2 && y <= 5) && (x == 2 || x == 5 || y == 2 || y == 5);
+            QCOMPARE(target.pixel(x, y), onMarker ? k_markerColor : qRgb(0, 0, 0));
+        }
+    }
+}
+
+[[maybe_unused]] void PixelZoomTest::benchmarkPixelZoom_data() {
+    addZoomFactors();
+}
+
+[[maybe_unused]] void PixelZoomTest::benchmarkPixelZoom() {
+    QFETCH(int, factor);
+
+    const Scene scene = createScene(factor);
+    QImage target(k_size, k_size, QImage::Format_RGB32);
+
+    QBENCHMARK {
+        paintWithPixelZoom(scene, target);
+    }
+}
+
+[[maybe_unused]] void PixelZoomTest::benchmarkPainter_data() {
+    addZoomFactors();
+}
+
+[[maybe_unused]] void PixelZoomTest::benchmarkPainter() {
+    QFETCH(int, factor);
+
+    const Scene scene = createScene(factor);
+    QImage target(k_size, k_size, QImage::Format_RGB32);
+
+    QBENCHMARK {
+        paintWithPainter(scene, target);
+    }
+}
+
+QTEST_MAIN(PixelZoomTest)
+
+#include "PixelZoomTest.moc"
@@ -0,0 +1,291 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <meazure/measurement/MeasurementEngine.h>
+#include <meazure/measurement/ScreenLayout.h>
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <QSizeF>
+#include <QtMath>
+#include <vector>
+#include <cmath>
+
+
+class MeasurementEngineTest : public QObject {
+
+Q_OBJECT
+
+private slots:
+    [[maybe_unused]] void testDefaults();
+    [[maybe_unused]] void testMeasurePoint();
+    [[maybe_unused]] void testLinearUnits_data();
+    [[maybe_unused]] void testLinearUnits();
+    [[maybe_unused]] void testCustomUnits();
+    [[maybe_unused]] void testMeasureLine();
+    [[maybe_unused]] void testMeasureLineSecondScreen();
+    [[maybe_unused]] void testMeasureLineInvertY();
+    [[maybe_unused]] void testMeasureLines();
+    [[maybe_unused]] void testMeasureCircle();
+    [[maybe_unused]] void testMeasureAngle();
+    [[maybe_unused]] void benchmarkMeasureLine();
+    [[maybe_unused]] void benchmarkMeasureLines();
+
+private:
+    static constexpr int k_benchmarkLines { 1000 };
+
+    /// A 96 ppi primary screen with a 192 ppi screen to its right.
+    ///
+    static std::vector<ScreenLayout::Screen> createScreens();
+
+    static void createBenchmarkLines(std::vector<QPoint>& p1, std::vector<QPoint>& p2);
+};
+
+
+std::vector<ScreenLayout::Screen> MeasurementEngineTest::createScreens() {
+    return {
+        { QRect(0, 0, 1920, 1080), QSizeF(96.0, 96.0), "Primary" },
+        { QRect(1920, 0, 1280, 1024), QSizeF(192.0, 192.0), "Secondary" }
+    };
+}
+
+void MeasurementEngineTest::createBenchmarkLines(std::vector<QPoint>& p1, std::vector<QPoint>& p2) {
+    for (int i = 0; i < k_benchmarkLines; i++) {
+        p1.emplace_back(i, i % 1000);
+        p2.emplace_back(3000 - i, 1000 - i % 1000);
+    }
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testDefaults() {
+    const ScreenLayout layout(createScreens());
+    const MeasurementEngine engine(&layout);
+
+    QCOMPARE(engine.getLinearUnitsId(), PixelsId);
+    QCOMPARE(engine.getLinearUnits()->getUnitsId(), PixelsId);
+    QCOMPARE(engine.getAngularUnitsId(), DegreesId);
+    QCOMPARE(engine.getAngularUnits()->getUnitsId(), DegreesId);
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testMeasurePoint() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+
+    const MeasurementSnapshot snapshot = engine.measurePoint(QPoint(100, 50));
+    QCOMPARE(snapshot.changed, MeasurementFields(XY1Changed));
+    QCOMPARE(snapshot.coord1, QPointF(100.0, 50.0));
+    QCOMPARE(snapshot.rawPos1, QPoint(100, 50));
+
+    engine.setOrigin(QPoint(10, 20));
+    QCOMPARE(engine.measurePoint(QPoint(100, 50)).coord1, QPointF(90.0, 30.0));
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testLinearUnits_data() {
+    QTest::addColumn<int>("unitsId");
+    QTest::addColumn<QPointF>("primaryCoord");
+    QTest::addColumn<QPointF>("secondaryCoord");
+
+    // One inch from the top left of each screen.
+    QTest::newRow("pixels") << static_cast<int>(PixelsId) << QPointF(96.0, 96.0) << QPointF(2112.0, 192.0);
+    QTest::newRow("points") << static_cast<int>(PointsId) << QPointF(72.0, 72.0) << QPointF(792.0, 72.0);
+    QTest::newRow("twips") << static_cast<int>(TwipsId) << QPointF(1440.0, 1440.0) << QPointF(15840.0, 1440.0);
+    QTest::newRow("inches") << static_cast<int>(InchesId) << QPointF(1.0, 1.0) << QPointF(11.0, 1.0);
+    QTest::newRow("centimeters") << static_cast<int>(CentimetersId) << QPointF(2.54, 2.54) << QPointF(27.94, 2.54);
+    QTest::newRow("millimeters") << static_cast<int>(MillimetersId) << QPointF(25.4, 25.4) << QPointF(279.4, 25.4);
+    QTest::newRow("picas") << static_cast<int>(PicasId) << QPointF(6.0, 6.0) << QPointF(66.0, 6.0);
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testLinearUnits() {
+    QFETCH(int, unitsId);
+    QFETCH(QPointF, primaryCoord);
+    QFETCH(QPointF, secondaryCoord);
+
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+    engine.setLinearUnits(static_cast<LinearUnitsId>(unitsId));
+    QCOMPARE(engine.getLinearUnitsId(), static_cast<LinearUnitsId>(unitsId));
+
+    QCOMPARE(engine.measurePoint(QPoint(96, 96)).coord1, primaryCoord);
+    QCOMPARE(engine.measurePoint(QPoint(2112, 192)).coord1, secondaryCoord);
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testCustomUnits() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+    engine.getCustomUnits()->setScaleBasis(CustomUnits::PixelBasis);
+    engine.getCustomUnits()->setScaleFactor(2.0);
+    engine.setLinearUnits(CustomId);
+
+    QCOMPARE(engine.getLinearUnitsId(), CustomId);
+    QCOMPARE(engine.measurePoint(QPoint(96, 48)).coord1, QPointF(48.0, 24.0));
+
+    engine.getCustomUnits()->setScaleBasis(CustomUnits::InchBasis);
+    QCOMPARE(engine.measurePoint(QPoint(192, 96)).coord1, QPointF(1.0, 0.5));
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testMeasureLine() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+
+    MeasurementSnapshot snapshot = engine.measureLine(QPoint(0, 0), QPoint(100, 100));
+    QCOMPARE(snapshot.changed, XY1Changed | XY2Changed | WHChanged | DistChanged | AngleChanged | AreaChanged |
+                               AspectChanged);
+    QCOMPARE(snapshot.coord1, QPointF(0.0, 0.0));
+    QCOMPARE(snapshot.coord2, QPointF(100.0, 100.0));
+    QCOMPARE(snapshot.rawPos2, QPoint(100, 100));
+    QCOMPARE(snapshot.widthHeight, QSizeF(101.0, 101.0));
+    QCOMPARE(snapshot.distance, std::hypot(101.0, 101.0));
+    QCOMPARE(snapshot.angle, 45.0);
+    QCOMPARE(snapshot.area, 10201.0);
+    QCOMPARE(snapshot.aspect, 1.0);
+
+    engine.setAngularUnits(RadiansId);
+    snapshot = engine.measureLine(QPoint(0, 0), QPoint(100, 100));
+    QCOMPARE(snapshot.angle, M_PI / 4.0);
+
+    snapshot = engine.measureLine(QPoint(40, 60), QPoint(10, 20));
+    QCOMPARE(snapshot.widthHeight, QSizeF(31.0, 41.0));
+    QCOMPARE(snapshot.area, 31.0 * 41.0);
+    QCOMPARE(snapshot.aspect, 31.0 / 41.0);
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testMeasureLineSecondScreen() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+    engine.setLinearUnits(InchesId);
+
+    const MeasurementSnapshot snapshot = engine.measureLine(QPoint(1920, 0), QPoint(2111, 191));
+    QCOMPARE(snapshot.coord1, QPointF(10.0, 0.0));
+    QCOMPARE(snapshot.widthHeight, QSizeF(1.0, 1.0));
+    QCOMPARE(snapshot.distance, std::sqrt(2.0));
+    QCOMPARE(snapshot.area, 1.0);
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testMeasureLineInvertY() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+    engine.setInvertY(true);
+
+    // With the system origin, the origin is at the bottom of the virtual screen.
+    const MeasurementSnapshot snapshot = engine.measureLine(QPoint(0, 0), QPoint(100, 100));
+    QCOMPARE(snapshot.coord1, QPointF(0.0, 1079.0));
+    QCOMPARE(snapshot.coord2, QPointF(100.0, 979.0));
+    QCOMPARE(snapshot.widthHeight, QSizeF(101.0, 101.0));
+    QCOMPARE(snapshot.angle, -45.0);
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testMeasureLines() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+    engine.setLinearUnits(MillimetersId);
+    engine.setOrigin(QPoint(500, 400));
+    engine.setInvertY(true);
+
+    const std::vector<QPoint> p1 = { QPoint(0, 0), QPoint(1919, 1079), QPoint(2000, 100), QPoint(10, 10) };
+    const std::vector<QPoint> p2 = { QPoint(100, 200), QPoint(1920, 1000), QPoint(2500, 900), QPoint(3000, 20) };
+    std::vector<MeasurementSnapshot> snapshots(p1.size());
+    engine.measureLines(p1.data(), p2.data(), snapshots.data(), static_cast<int>(p1.size()));
+
+    for (std::size_t i = 0; i < p1.size(); i++) {
+        const MeasurementSnapshot expected = engine.measureLine(p1[i], p2[i]);
+        const MeasurementSnapshot& actual = snapshots[i];
+        QCOMPARE(actual.changed, expected.changed);
+        QCOMPARE(actual.coord1, expected.coord1);
+        QCOMPARE(actual.rawPos1, expected.rawPos1);
+        QCOMPARE(actual.coord2, expected.coord2);
+        QCOMPARE(actual.rawPos2, expected.rawPos2);
+        QCOMPARE(actual.widthHeight, expected.widthHeight);
+        QCOMPARE(actual.distance, expected.distance);
+        QCOMPARE(actual.angle, expected.angle);
+        QCOMPARE(actual.area, expected.area);
+        QCOMPARE(actual.aspect, expected.aspect);
+    }
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testMeasureCircle() {
+    const ScreenLayout layout(createScreens());
+    const MeasurementEngine engine(&layout);
+
+    const MeasurementSnapshot snapshot = engine.measureCircle(QPoint(100, 100), QPoint(130, 140));
+    QCOMPARE(snapshot.changed, XY1Changed | XYVChanged | WHChanged | DistChanged | AngleChanged | AreaChanged |
+                               AspectChanged);
+    QCOMPARE(snapshot.coord1, QPointF(130.0, 140.0));
+    QCOMPARE(snapshot.coordV, QPointF(100.0, 100.0));
+    QCOMPARE(snapshot.rawPosV, QPoint(100, 100));
+    QCOMPARE(snapshot.distance, 50.0);
+    QCOMPARE(snapshot.widthHeight, QSizeF(100.0, 100.0));
+    QCOMPARE(snapshot.area, M_PI * 2500.0);
+    QCOMPARE(snapshot.aspect, 1.0);
+    QCOMPARE(snapshot.angle, qRadiansToDegrees(std::atan2(40.0, 30.0)));
+}
+
+[[maybe_unused]] void MeasurementEngineTest::testMeasureAngle() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+
+    MeasurementSnapshot snapshot = engine.measureAngle(QPoint(100, 100), QPoint(200, 100), QPoint(150, 200));
+    QCOMPARE(snapshot.changed, XY1Changed | XY2Changed | XYVChanged | AngleChanged);
+    QCOMPARE(snapshot.coord1, QPointF(200.0, 100.0));
+    QCOMPARE(snapshot.coord2, QPointF(150.0, 200.0));
+    QCOMPARE(snapshot.coordV, QPointF(100.0, 100.0));
+    QCOMPARE(snapshot.angle, qRadiansToDegrees(std::atan2(2.0, 1.0)));
+
+    engine.setSupplementalAngle(true);
+    snapshot = engine.measureAngle(QPoint(100, 100), QPoint(200, 100), QPoint(150, 200));
+    QCOMPARE(snapshot.angle, 180.0 - qRadiansToDegrees(std::atan2(2.0, 1.0)));
+}
+
+[[maybe_unused]] void MeasurementEngineTest::benchmarkMeasureLine() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+    engine.setLinearUnits(InchesId);
+
+    std::vector<QPoint> p1;
+    std::vector<QPoint> p2;
+    createBenchmarkLines(p1, p2);
+
+    double sum = 0.0;
+    QBENCHMARK {
+        for (std::size_t i = 0; i < p1.size(); i++) {
+            sum += engine.measureLine(p1[i], p2[i]).distance;
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+[[maybe_unused]] void MeasurementEngineTest::benchmarkMeasureLines() {
+    const ScreenLayout layout(createScreens());
+    MeasurementEngine engine(&layout);
+    engine.setLinearUnits(InchesId);
+
+    std::vector<QPoint> p1;
+    std::vector<QPoint> p2;
+    createBenchmarkLines(p1, p2);
+    std::vector<MeasurementSnapshot> snapshots(p1.size());
+
+    double sum = 0.0;
+    QBENCHMARK {
+        engine.measureLines(p1.data(), p2.data(), snapshots.data(), k_benchmarkLines);
+        sum += snapshots.back().distance;
+    }
+    QVERIFY(sum != 0.0);
+}
+
+
+QTEST_GUILESS_MAIN(MeasurementEngineTest)
+
+#include "MeasurementEngineTest.moc"
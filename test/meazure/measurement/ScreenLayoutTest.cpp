@@ -0,0 +1,146 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <meazure/measurement/ScreenLayout.h>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QSizeF>
+#include <QString>
+#include <vector>
+
+
+class ScreenLayoutTest : public QObject {
+
+Q_OBJECT
+
+private slots:
+    [[maybe_unused]] void testScreens();
+    [[maybe_unused]] void testScreenForPoint();
+    [[maybe_unused]] void testScreenForRect();
+    [[maybe_unused]] void testScreenRes();
+    [[maybe_unused]] void testInvalidScreen();
+    [[maybe_unused]] void testConstrainPosition();
+    [[maybe_unused]] void testEmpty();
+
+private:
+    /// A 96 ppi primary screen with a shorter, higher resolution screen to its right.
+    ///
+    static std::vector<ScreenLayout::Screen> createScreens();
+};
+
+
+std::vector<ScreenLayout::Screen> ScreenLayoutTest::createScreens() {
+    return {
+        { QRect(0, 0, 1920, 1080), QSizeF(96.0, 96.0), "Primary" },
+        { QRect(1920, 0, 1280, 1024), QSizeF(192.0, 144.0), "Secondary" }
+    };
+}
+
+
+[[maybe_unused]] void ScreenLayoutTest::testScreens() {
+    const ScreenLayout layout(createScreens());
+
+    QCOMPARE(layout.getNumScreens(), 2);
+    QCOMPARE(layout.getVirtualRect(), QRect(0, 0, 3200, 1080));
+    QCOMPARE(layout.getAvailableVirtualRect(), QRect(0, 0, 3200, 1080));
+    QCOMPARE(layout.getCenter(), QRect(0, 0, 1920, 1080).center());
+
+    QCOMPARE(layout.getScreenRect(0), QRect(0, 0, 1920, 1080));
+    QCOMPARE(layout.getScreenRect(1), QRect(1920, 0, 1280, 1024));
+    QVERIFY(layout.isPrimary(0));
+    QVERIFY(!layout.isPrimary(1));
+    QCOMPARE(layout.getScreenName(0), QString("Primary"));
+    QCOMPARE(layout.getScreenName(1), QString("Secondary"));
+    QCOMPARE(layout.getPlatformScale(1), QSizeF(1.0, 1.0));
+    QCOMPARE(layout.getCursorSize(1), ScreenLayout::k_cursorSize);
+
+    QVERIFY(!layout.sizeChanged());
+    QVERIFY(layout.grabScreen(0, 0, 10, 10).isNull());
+    QVERIFY(layout.isGrabThreadSafe());
+    QCOMPARE(layout.screenForWindow(nullptr), -1);
+}
+
+[[maybe_unused]] void ScreenLayoutTest::testScreenForPoint() {
+    const ScreenLayout layout(createScreens());
+
+    QCOMPARE(layout.screenForPoint(QPoint(0, 0)), 0);
+    QCOMPARE(layout.screenForPoint(QPoint(1919, 1079)), 0);
+    QCOMPARE(layout.screenForPoint(QPoint(1920, 0)), 1);
+    QCOMPARE(layout.screenForPoint(QPoint(3199, 1023)), 1);
+    QCOMPARE(layout.screenForPoint(QPoint(3199, 1024)), -1);
+    QCOMPARE(layout.screenForPoint(QPoint(-1, 0)), -1);
+}
+
+[[maybe_unused]] void ScreenLayoutTest::testScreenForRect() {
+    const ScreenLayout layout(createScreens());
+
+    QCOMPARE(layout.screenForRect(QRect(1900, 100, 100, 100)), 1);
+    QCOMPARE(layout.screenForRect(QRect(1800, 100, 100, 100)), 0);
+    QCOMPARE(layout.screenForRect(QRect(2000, 1050, 100, 10)), -1);
+}
+
+[[maybe_unused]] void ScreenLayoutTest::testScreenRes() {
+    const ScreenLayout layout(createScreens());
+
+    QCOMPARE(layout.getScreenRes(0), QSizeF(96.0, 96.0));
+    QCOMPARE(layout.getScreenRes(1), QSizeF(192.0, 144.0));
+
+    bool useManualRes = false;
+    QSizeF manualRes;
+    layout.getScreenRes(1, useManualRes, manualRes);
+    QVERIFY(useManualRes);
+    QCOMPARE(manualRes, QSizeF(192.0, 144.0));
+
+    QVERIFY(layout.isManualRes(0));
+    QVERIFY(!layout.isCalibrationRequired());
+}
+
+[[maybe_unused]] void ScreenLayoutTest::testInvalidScreen() {
+    const ScreenLayout layout(createScreens());
+
+    QCOMPARE(layout.getScreenRect(-1), QRect());
+    QCOMPARE(layout.getScreenRect(2), QRect());
+    QCOMPARE(layout.getScreenRes(-1), QSizeF(0.0, 0.0));
+    QVERIFY(!layout.isManualRes(2));
+    QVERIFY(!layout.isPrimary(-1));
+    QVERIFY(layout.getScreenName(2).isEmpty());
+}
+
+[[maybe_unused]] void ScreenLayoutTest::testConstrainPosition() {
+    const ScreenLayout layout(createScreens());
+
+    QCOMPARE(layout.constrainPosition(QPoint(100, 100)), QPoint(100, 100));
+    QCOMPARE(layout.constrainPosition(QPoint(-10, 100)), QPoint(0, 100));
+    QCOMPARE(layout.constrainPosition(QPoint(3000, 1050)), QPoint(3000, 1023));
+}
+
+[[maybe_unused]] void ScreenLayoutTest::testEmpty() {
+    const ScreenLayout layout({});
+
+    QCOMPARE(layout.getNumScreens(), 0);
+    QCOMPARE(layout.getVirtualRect(), QRect());
+    QCOMPARE(layout.getCenter(), QPoint());
+    QCOMPARE(layout.screenForPoint(QPoint(0, 0)), -1);
+    QCOMPARE(layout.constrainPosition(QPoint(5, 5)), QPoint(5, 5));
+}
+
+
+QTEST_GUILESS_MAIN(ScreenLayoutTest)
+
+#include "ScreenLayoutTest.moc"
@@ -22,6 +22,7 @@
 #include <QRect>
 #include <QPoint>
 #include <QSizeF>
+#include <vector>
 
 
 class MockScreenInfoProvider : public ScreenInfoProvider {
@@ -29,15 +30,19 @@ class MockScreenInfoProvider : public ScreenInfoProvider {
 public:
     MockScreenInfoProvider() : m_rect(0, 0, 1280, 1024) {
         m_center = m_rect.center();
-        m_res.setWidth(96.0);
-        m_res.setHeight(96.0);
+        m_screens.push_back({ m_rect, QSizeF(96.0, 96.0) });
     }
 
     [[nodiscard]] int getNumScreens() const override {
-        return 1;
+        return static_cast<int>(m_screens.size());
     }
 
-    [[nodiscard]] int screenForPoint(const QPoint&) const override {
+    [[nodiscard]] int screenForPoint(const QPoint& point) const override {
+        for (std::size_t i = 0; i < m_screens.size(); i++) {
+            if (m_screens[i].rect.contains(point)) {
+                return static_cast<int>(i);
+            }
+        }
         return 0;
     }
 
@@ -61,21 +66,21 @@ public:
         return m_rect;
     }
 
-    [[nodiscard]] QRect getScreenRect(int /* screenIndex */) const override {
-        return m_rect;
+    [[nodiscard]] QRect getScreenRect(int screenIndex) const override {
+        return getScreen(screenIndex).rect;
     }
 
     [[nodiscard]] QSizeF getPlatformScale(int /* screenIndex */) const override {
         return { 1.0, 1.0 };
     }
 
-    void getScreenRes(int /* screenIndex */, bool& useManualRes, QSizeF& manualRes) const override {
+    void getScreenRes(int screenIndex, bool& useManualRes, QSizeF& manualRes) const override {
         useManualRes = false;
-        manualRes = m_res;
+        manualRes = getScreen(screenIndex).res;
     }
 
-    [[nodiscard]] QSizeF getScreenRes(int /* screenIndex */) const override {
-        return m_res;
+    [[nodiscard]] QSizeF getScreenRes(int screenIndex) const override {
+        return getScreen(screenIndex).res;
     }
 
     [[nodiscard]] bool isManualRes(int /* screenIndex */) const override {
@@ -110,8 +115,35 @@ public:
         return {};
     }
 
+    [[nodiscard]] bool isGrabThreadSafe() const override {
+        return true;
+    }
+
+    /// Sets the resolution of the first screen.
+    ///
+    void setScreenRes(const QSizeF& res) {
+        m_screens.front().res = res;
+    }
+
+    /// Adds a screen to the layout. Points that are not on any screen are reported as being on the first screen.
+    ///
+    void addScreen(const QRect& rect, const QSizeF& res) {
+        m_screens.push_back({ rect, res });
+        m_rect = m_rect.united(rect);
+    }
+
 private:
+    struct Screen {
+        QRect rect;
+        QSizeF res;
+    };
+
+    [[nodiscard]] const Screen& getScreen(int screenIndex) const {
+        const bool valid = screenIndex >= 0 && screenIndex < static_cast<int>(m_screens.size());
+        return m_screens[valid ? static_cast<std::size_t>(screenIndex) : 0];
+    }
+
     QRect m_rect;
     QPoint m_center;
-    QSizeF m_res;
+    std::vector<Screen> m_screens;
 };
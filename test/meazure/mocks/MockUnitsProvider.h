@@ -149,6 +149,14 @@ public:
         return m_linearUnits->unconvertPos(pos);
     }
 
+    void convertCoords(const QPoint* pos, QPointF* coords, int count) const override {
+        m_linearUnits->convertCoords(pos, coords, count);
+    }
+
+    void unconvertCoords(const QPointF* coords, QPoint* pos, int count) const override {
+        m_linearUnits->unconvertCoords(coords, pos, count);
+    }
+
     [[nodiscard]] QSizeF convertRes(const QSizeF& res) const override {
         return m_linearUnits->convertRes(res);
     }
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QtPlugin>
+#include <meazure/ui/ImageMimeData.h>
+#include <QImage>
+#include <QByteArray>
+
+Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+Q_IMPORT_PLUGIN(QSvgIconPlugin)
+
+
+class ImageMimeDataTest : public QObject {
+
+Q_OBJECT
+
+private slots:
+    [[maybe_unused]] void testFormats();
+    [[maybe_unused]] void testNullImage();
+    [[maybe_unused]] void testImage();
+    [[maybe_unused]] void testEncode_data();
+    [[maybe_unused]] void testEncode();
+    [[maybe_unused]] void testCached();
+    [[maybe_unused]] void testPrepared();
+
+private:
+    static QImage createImage();
+};
+
+
+QImage ImageMimeDataTest::createImage() {
+    QImage image(40, 30, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); y++) {
+        for (int x = 0; x < image.width(); x++) {
+            image.setPixel(x, y, qRgb(x * 6, y * 8, (x + y) * 3));
+        }
+    }
+    return image;
+}
+
+[[maybe_unused]] void ImageMimeDataTest::testFormats() {
+    const ImageMimeData mimeData(createImage());
+
+    QVERIFY(mimeData.hasImage());
+    QVERIFY(mimeData.hasFormat(ImageMimeData::k_pngFormat));
+    QVERIFY(mimeData.hasFormat(ImageMimeData::k_bmpFormat));
+    QVERIFY(!mimeData.hasFormat("image/jpeg"));
+    QVERIFY(!mimeData.hasText());
+    QCOMPARE(mimeData.formats().size(), 3);
+}
+
+[[maybe_unused]] void ImageMimeDataTest::testNullImage() {
+    const ImageMimeData mimeData((QImage()));
+
+    QVERIFY(!mimeData.hasImage());
+    QVERIFY(mimeData.formats().isEmpty());
+    QVERIFY(mimeData.data(ImageMimeData::k_pngFormat).isEmpty());
+}
+
+[[maybe_unused]] void ImageMimeDataTest::testImage() {
+    const QImage image = createImage();
+    const ImageMimeData mimeData(image);
+
+    QCOMPARE(qvariant_cast<QImage>(mimeData.imageData()), image);
+}
+
+[[maybe_unused]] void ImageMimeDataTest::testEncode_data() {
+    QTest::addColumn<QString>("mimeType");
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("png") << ImageMimeData::k_pngFormat << "PNG";
+    QTest::newRow("bmp") << ImageMimeData::k_bmpFormat << "BMP";
+}
+
+[[maybe_unused]] void ImageMimeDataTest::testEncode() {
+    QFETCH(QString, mimeType);
+    QFETCH(QString, format);
+
+    const QImage image = createImage();
+    const ImageMimeData mimeData(image);
+
+    const QByteArray data = mimeData.data(mimeType);
+    QVERIFY(!data.isEmpty());
+
+    const QImage decoded = QImage::fromData(data, format.toLatin1().constData());
+    QCOMPARE(decoded.convertToFormat(QImage::Format_RGB32), image);
+}
+
+[[maybe_unused]] void ImageMimeDataTest::testCached() {
+    const ImageMimeData mimeData(createImage());
+
+    const QByteArray data1 = mimeData.data(ImageMimeData::k_pngFormat);
+    const QByteArray data2 = mimeData.data(ImageMimeData::k_pngFormat);
+
+    // The cached encoding is shared rather than encoded again.
+    QCOMPARE(data1.constData(), data2.constData());
+}
+
+[[maybe_unused]] void ImageMimeDataTest::testPrepared() {
+    const QImage image = createImage();
+    const ImageMimeData mimeData(image);
+
+    mimeData.prepare(ImageMimeData::k_pngFormat);
+    mimeData.prepare(ImageMimeData::k_pngFormat);
+    mimeData.prepare("text/plain");
+
+    const QImage decoded = QImage::fromData(mimeData.data(ImageMimeData::k_pngFormat), "PNG");
+    QCOMPARE(decoded.convertToFormat(QImage::Format_RGB32), image);
+}
+
+QTEST_MAIN(ImageMimeDataTest)
+
+#include "ImageMimeDataTest.moc"
@@ -22,9 +22,11 @@
 #include <test/meazure/testing/TestHelpers.h>
 #include <test/meazure/mocks/MockScreenInfoProvider.h>
 #include <QPoint>
+#include <QRect>
 #include <QSizeF>
 #include <QString>
 #include <QSignalSpy>
+#include <vector>
 
 Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
 Q_IMPORT_PLUGIN(QSvgIconPlugin)
@@ -49,6 +51,18 @@ private slots:
     [[maybe_unused]] void testCentimeterUnits();
     [[maybe_unused]] void testMillimeterUnits();
     [[maybe_unused]] void testCustomUnits();
+    [[maybe_unused]] void testScreenFactors();
+    [[maybe_unused]] void testCustomUnitsScreenFactors();
+    [[maybe_unused]] void testConvertCoords();
+    [[maybe_unused]] void testConvertCoordsOverlap();
+    [[maybe_unused]] void testConvertCoordsEmpty();
+    [[maybe_unused]] void benchmarkConvertCoord();
+    [[maybe_unused]] void benchmarkUnconvertCoord();
+    [[maybe_unused]] void benchmarkConvertCoords();
+    [[maybe_unused]] void benchmarkUnconvertCoords();
+
+private:
+    static constexpr int k_benchmarkPoints { 1000 };
 };
 
 
@@ -508,6 +522,190 @@ void verifyFromPixels(LinearUnits& units, double xfactor, double yfactor) {
     MEA_CHECK(verifyFromPixels(units, 0.0050000000000000001, 0.0055555555555555558));
 }
 
+[[maybe_unused]] void UnitsTest::testScreenFactors() {
+    MockScreenInfoProvider screenProvider;
+    InchUnits units(&screenProvider);
+
+    const QPoint pos(192, 96);
+    QCOMPARE(units.convertCoord(pos), QPointF(2.0, 1.0));
+    QCOMPARE(units.convertPos(pos), QPointF(2.0, 1.0));
+
+    units.setOrigin(QPoint(96, 0));
+    QCOMPARE(units.convertCoord(pos), QPointF(1.0, 1.0));
+    QCOMPARE(units.convertPos(pos), QPointF(2.0, 1.0));
+
+    units.setInvertY(true);
+    QCOMPARE(units.convertCoord(pos), QPointF(1.0, -1.0));
+    QCOMPARE(units.unconvertCoord(QPointF(1.0, -1.0)), pos);
+
+    screenProvider.setScreenRes(QSizeF(48.0, 48.0));
+    units.invalidateScreenFactors();
+    QCOMPARE(units.convertCoord(pos), QPointF(2.0, -2.0));
+    QCOMPARE(units.convertPos(pos), QPointF(4.0, 2.0));
+    QCOMPARE(units.unconvertCoord(QPointF(2.0, -2.0)), pos);
+    QCOMPARE(units.unconvertPos(QPointF(4.0, 2.0)), pos);
+
+    // Positions that are not on any screen are converted using a zero resolution.
+    QCOMPARE(units.unconvertPos(QPointF(-1.0, -1.0)), QPoint(0, 0));
+}
+
+[[maybe_unused]] void UnitsTest::testCustomUnitsScreenFactors() {
+    const MockScreenInfoProvider screenProvider;
+    CustomUnits units(&screenProvider);
+
+    const QPoint pos(192, 96);
+    QCOMPARE(units.convertCoord(pos), QPointF(192.0, 96.0));
+
+    units.setScaleFactor(2.0);
+    QCOMPARE(units.convertCoord(pos), QPointF(96.0, 48.0));
+
+    units.setScaleBasis(CustomUnits::InchBasis);
+    QCOMPARE(units.convertCoord(pos), QPointF(1.0, 0.5));
+    QCOMPARE(units.unconvertCoord(QPointF(1.0, 0.5)), pos);
+}
+
+[[maybe_unused]] void UnitsTest::testConvertCoords() {
+    MockScreenInfoProvider screenProvider;
+    screenProvider.addScreen(QRect(1280, 0, 1280, 1024), QSizeF(192.0, 192.0));
+    InchUnits units(&screenProvider);
+    units.setOrigin(QPoint(100, 200));
+    units.setInvertY(true);
+
+    // Runs of positions on the same screen, separated by positions on the other screen and off all screens.
+    const std::vector<QPoint> positions = {
+        QPoint(0, 0), QPoint(96, 192), QPoint(1279, 1023), QPoint(1280, 0), QPoint(2000, 500), QPoint(500, 500),
+        QPoint(-10, -10), QPoint(1500, 1000), QPoint(2559, 1023)
+    };
+    const int count = static_cast<int>(positions.size());
+
+    std::vector<QPointF> coords(positions.size());
+    units.convertCoords(positions.data(), coords.data(), count);
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        QCOMPARE(coords[i], units.convertCoord(positions[i]));
+    }
+
+    std::vector<QPoint> unconverted(positions.size());
+    units.unconvertCoords(coords.data(), unconverted.data(), count);
+    for (std::size_t i = 0; i < coords.size(); i++) {
+        QCOMPARE(unconverted[i], units.unconvertCoord(coords[i]));
+    }
+
+    units.setInvertY(false);
+    units.convertCoords(positions.data(), coords.data(), count);
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        QCOMPARE(coords[i], units.convertCoord(positions[i]));
+    }
+
+    units.unconvertCoords(coords.data(), unconverted.data(), count);
+    for (std::size_t i = 0; i < coords.size(); i++) {
+        QCOMPARE(unconverted[i], units.unconvertCoord(coords[i]));
+    }
+    QCOMPARE(unconverted[1], positions[1]);
+}
+
+[[maybe_unused]] void UnitsTest::testConvertCoordsOverlap() {
+    // The second screen overlaps the right half of the first screen. Positions in the overlap are on the first
+    // screen, even when they follow positions on the second screen.
+    MockScreenInfoProvider screenProvider;
+    screenProvider.addScreen(QRect(640, 0, 1280, 1024), QSizeF(192.0, 192.0));
+    InchUnits units(&screenProvider);
+
+    const std::vector<QPoint> positions = {
+        QPoint(1500, 100), QPoint(1000, 100), QPoint(1800, 100), QPoint(700, 500), QPoint(100, 100)
+    };
+    const int count = static_cast<int>(positions.size());
+
+    std::vector<QPointF> coords(positions.size());
+    units.convertCoords(positions.data(), coords.data(), count);
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        QCOMPARE(coords[i], units.convertCoord(positions[i]));
+    }
+
+    std::vector<QPoint> unconverted(positions.size());
+    units.unconvertCoords(coords.data(), unconverted.data(), count);
+    for (std::size_t i = 0; i < coords.size(); i++) {
+        QCOMPARE(unconverted[i], units.unconvertCoord(coords[i]));
+    }
+}
+
+[[maybe_unused]] void UnitsTest::testConvertCoordsEmpty() {
+    const MockScreenInfoProvider screenProvider;
+    const InchUnits units(&screenProvider);
+
+    units.convertCoords(nullptr, nullptr, 0);
+    units.unconvertCoords(nullptr, nullptr, 0);
+}
+
+[[maybe_unused]] void UnitsTest::benchmarkConvertCoord() {
+    const MockScreenInfoProvider screenProvider;
+    InchUnits units(&screenProvider);
+    units.setOrigin(QPoint(100, 200));
+    units.setInvertY(true);
+
+    double sum = 0.0;
+    QBENCHMARK {
+        for (int i = 0; i < k_benchmarkPoints; i++) {
+            sum += units.convertCoord(QPoint(i, i)).y();
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+[[maybe_unused]] void UnitsTest::benchmarkUnconvertCoord() {
+    const MockScreenInfoProvider screenProvider;
+    InchUnits units(&screenProvider);
+    units.setOrigin(QPoint(100, 200));
+    units.setInvertY(true);
+
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < k_benchmarkPoints; i++) {
+            sum += units.unconvertCoord(QPointF(i / 100.0, i / 100.0)).x();
+        }
+    }
+    QVERIFY(sum != 0);
+}
+
+[[maybe_unused]] void UnitsTest::benchmarkConvertCoords() {
+    const MockScreenInfoProvider screenProvider;
+    InchUnits units(&screenProvider);
+    units.setOrigin(QPoint(100, 200));
+    units.setInvertY(true);
+
+    std::vector<QPoint> positions;
+    for (int i = 0; i < k_benchmarkPoints; i++) {
+        positions.emplace_back(i, i);
+    }
+    std::vector<QPointF> coords(positions.size());
+
+    double sum = 0.0;
+    QBENCHMARK {
+        units.convertCoords(positions.data(), coords.data(), k_benchmarkPoints);
+        sum += coords.back().y();
+    }
+    QVERIFY(sum != 0.0);
+}
+
+[[maybe_unused]] void UnitsTest::benchmarkUnconvertCoords() {
+    const MockScreenInfoProvider screenProvider;
+    InchUnits units(&screenProvider);
+    units.setOrigin(QPoint(100, 200));
+    units.setInvertY(true);
+
+    std::vector<QPointF> coords;
+    for (int i = 0; i < k_benchmarkPoints; i++) {
+        coords.emplace_back(i / 100.0, i / 100.0);
+    }
+    std::vector<QPoint> positions(coords.size());
+
+    int sum = 0;
+    QBENCHMARK {
+        units.unconvertCoords(coords.data(), positions.data(), k_benchmarkPoints);
+        sum += positions.back().x();
+    }
+    QVERIFY(sum != 0);
+}
+
 
 QTEST_MAIN(UnitsTest)
 
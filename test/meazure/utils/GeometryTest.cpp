@@ -20,6 +20,7 @@
 #include <QPoint>
 #include <QSizeF>
 #include <meazure/utils/Geometry.h>
+#include <QRandomGenerator>
 #include <vector>
 
 Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
@@ -51,9 +52,51 @@ private slots:
     [[maybe_unused]] void testConstrainPointToRect();
     [[maybe_unused]] void testConstrainPointToRects();
     [[maybe_unused]] void testRotateAround();
+    [[maybe_unused]] void testRectIndexPoint();
+    [[maybe_unused]] void testRectIndexRect();
+    [[maybe_unused]] void testRectIndexRandom();
+    [[maybe_unused]] void benchmarkRectIndex_data();
+    [[maybe_unused]] void benchmarkRectIndex();
+    [[maybe_unused]] void benchmarkContains_data();
+    [[maybe_unused]] void benchmarkContains();
+
+private:
+    static std::vector<QRect> createWindows(int count);
+    static std::vector<QPoint> createPoints();
+    static void addWindowCounts();
 };
 
 
+std::vector<QRect> GeometryTest::createWindows(int count) {
+    // Windows of typical sizes scattered over three 1920x1080 screens side by side.
+    QRandomGenerator random(count);
+    std::vector<QRect> windows;
+    for (int i = 0; i < count; i++) {
+        windows.emplace_back(random.bounded(5760), random.bounded(1080), random.bounded(100, 1200),
+                             random.bounded(100, 900));
+    }
+    return windows;
+}
+
+std::vector<QPoint> GeometryTest::createPoints() {
+    QRandomGenerator random(1);
+    std::vector<QPoint> points;
+    for (int i = 0; i < 1000; i++) {
+        points.emplace_back(random.bounded(5760), random.bounded(1080));
+    }
+    return points;
+}
+
+void GeometryTest::addWindowCounts() {
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("3 windows") << 3;
+    QTest::newRow("50 windows") << 50;
+    QTest::newRow("300 windows") << 300;
+    QTest::newRow("1000 windows") << 1000;
+}
+
+
 [[maybe_unused]] void GeometryTest::testAreaRect() {
     QCOMPARE(Geometry::area(QRect()), 0);
     QCOMPARE(Geometry::area(QRect(0, 0, 0, 0)), 0);
@@ -386,6 +429,113 @@ private slots:
     QCOMPARE(transform.m33(), 1.0);
 }
 
+[[maybe_unused]] void GeometryTest::testRectIndexPoint() {
+    const Geometry::RectIndex emptyIndex;
+    QCOMPARE(emptyIndex.size(), 0);
+    QCOMPARE(emptyIndex.find(QPoint(10, 20)), -1);
+
+    const Geometry::RectIndex nullIndex(std::vector<QRect> { QRect(), QRect() });
+    QCOMPARE(nullIndex.size(), 2);
+    QCOMPARE(nullIndex.find(QPoint()), -1);
+    QCOMPARE(nullIndex.find(QPoint(10, 20)), -1);
+
+    const Geometry::RectIndex index(std::vector<QRect> {
+        QRect(50, 50, 100, 100),
+        QRect(),
+        QRect(0, 0, 100, 200),
+        QRect(300, 400, 200, 300)
+    });
+    QCOMPARE(index.find(QPoint(30, 40)), 2);
+    QCOMPARE(index.find(QPoint(60, 60)), 0);
+    QCOMPARE(index.find(QPoint(149, 149)), 0);
+    QCOMPARE(index.find(QPoint(99, 199)), 2);
+    QCOMPARE(index.find(QPoint(100, 200)), -1);
+    QCOMPARE(index.find(QPoint(350, 500)), 3);
+    QCOMPARE(index.find(QPoint(700, 500)), -1);
+    QCOMPARE(index.find(QPoint(-1, 0)), -1);
+    QCOMPARE(index.at(3), QRect(300, 400, 200, 300));
+}
+
+[[maybe_unused]] void GeometryTest::testRectIndexRect() {
+    const Geometry::RectIndex emptyIndex;
+    QCOMPARE(emptyIndex.findBestOverlap(QRect()), -1);
+    QCOMPARE(emptyIndex.findBestOverlap(QRect(10, 20, 100, 200)), -1);
+
+    const Geometry::RectIndex index(std::vector<QRect> { QRect(0, 0, 100, 200), QRect(100, 0, 200, 300) });
+    QCOMPARE(index.findBestOverlap(QRect(50, 100, 10, 20)), 0);
+    QCOMPARE(index.findBestOverlap(QRect(150, 100, 10, 20)), 1);
+    QCOMPARE(index.findBestOverlap(QRect(50, 100, 75, 20)), 0);
+    QCOMPARE(index.findBestOverlap(QRect(80, 100, 75, 20)), 1);
+    QCOMPARE(index.findBestOverlap(QRect(90, 100, 20, 20)), 0);
+    QCOMPARE(index.findBestOverlap(QRect(400, 100, 20, 20)), -1);
+    QCOMPARE(index.findBestOverlap(QRect()), -1);
+}
+
+[[maybe_unused]] void GeometryTest::testRectIndexRandom() {
+    // The index must give the same answers as the linear search functions.
+    std::vector<QRect> windows = createWindows(300);
+    windows[10] = QRect();
+    const Geometry::RectIndex index(windows);
+
+    std::vector<QRect*> rects;
+    for (QRect& window : windows) {
+        rects.push_back(&window);
+    }
+
+    QRandomGenerator random(2);
+    for (int i = 0; i < 2000; i++) {
+        const QPoint point(random.bounded(-100, 6000), random.bounded(-100, 2000));
+        QCOMPARE(index.find(point), Geometry::contains(rects, point));
+
+        const QRect rect(point, QSize(random.bounded(500), random.bounded(500)));
+        QCOMPARE(index.findBestOverlap(rect), Geometry::contains(rects, rect));
+    }
+}
+
+[[maybe_unused]] void GeometryTest::benchmarkRectIndex_data() {
+    addWindowCounts();
+}
+
+[[maybe_unused]] void GeometryTest::benchmarkRectIndex() {
+    QFETCH(int, count);
+
+    const Geometry::RectIndex index(createWindows(count));
+    const std::vector<QPoint> points = createPoints();
+    int found = 0;
+
+    QBENCHMARK {
+        for (const QPoint& point : points) {
+            found += index.find(point);
+        }
+    }
+
+    QVERIFY(found != 0);
+}
+
+[[maybe_unused]] void GeometryTest::benchmarkContains_data() {
+    addWindowCounts();
+}
+
+[[maybe_unused]] void GeometryTest::benchmarkContains() {
+    QFETCH(int, count);
+
+    std::vector<QRect> windows = createWindows(count);
+    std::vector<QRect*> rects;
+    for (QRect& window : windows) {
+        rects.push_back(&window);
+    }
+    const std::vector<QPoint> points = createPoints();
+    int found = 0;
+
+    QBENCHMARK {
+        for (const QPoint& point : points) {
+            found += Geometry::contains(rects, point);
+        }
+    }
+
+    QVERIFY(found != 0);
+}
+
 
 QTEST_MAIN(GeometryTest)
 
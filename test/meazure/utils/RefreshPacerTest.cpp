@@ -0,0 +1,149 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QtPlugin>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <meazure/utils/RefreshPacer.h>
+
+Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+Q_IMPORT_PLUGIN(QSvgIconPlugin)
+
+
+class RefreshPacerTest : public QObject {
+
+Q_OBJECT
+
+private slots:
+    [[maybe_unused]] void testInterval();
+    [[maybe_unused]] void testSetRefreshRate();
+    [[maybe_unused]] void testScheduleAfterPause();
+    [[maybe_unused]] void testCoalesce();
+    [[maybe_unused]] void testContinuous();
+    [[maybe_unused]] void testStop();
+    [[maybe_unused]] void testMarkPerformed();
+};
+
+
+[[maybe_unused]] void RefreshPacerTest::testInterval() {
+    RefreshPacer pacer;
+    QVERIFY(pacer.getInterval() > 0);
+    QVERIFY(pacer.getInterval() <= 1000);
+    QVERIFY(!pacer.isScheduled());
+}
+
+[[maybe_unused]] void RefreshPacerTest::testSetRefreshRate() {
+    RefreshPacer pacer;
+
+    pacer.setRefreshRate(20);
+    QCOMPARE(pacer.getInterval(), 50);
+
+    pacer.setRefreshRate(240);
+    QCOMPARE(pacer.getInterval(), 4);
+
+    QSignalSpy spy(&pacer, &RefreshPacer::triggered);
+    pacer.setRefreshRate(10);
+    pacer.schedule();
+    QVERIFY(spy.wait(1000));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // A request made immediately after a trigger is delayed to the end of the specified interval.
+    pacer.schedule();
+    QVERIFY(spy.wait(1000));
+    QVERIFY(timer.elapsed() >= 50);
+}
+
+[[maybe_unused]] void RefreshPacerTest::testScheduleAfterPause() {
+    RefreshPacer pacer;
+    const QSignalSpy spy(&pacer, &RefreshPacer::triggered);
+
+    pacer.schedule();
+    QVERIFY(pacer.isScheduled());
+    QCOMPARE(spy.count(), 0);
+
+    // Triggered on the next pass through the event loop.
+    QTest::qWait(0);
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(!pacer.isScheduled());
+}
+
+[[maybe_unused]] void RefreshPacerTest::testCoalesce() {
+    RefreshPacer pacer;
+    const QSignalSpy spy(&pacer, &RefreshPacer::triggered);
+
+    pacer.schedule();
+    pacer.schedule();
+    pacer.schedule();
+
+    QTest::qWait(3 * pacer.getInterval());
+    QCOMPARE(spy.count(), 1);
+}
+
+[[maybe_unused]] void RefreshPacerTest::testContinuous() {
+    RefreshPacer pacer;
+    QSignalSpy spy(&pacer, &RefreshPacer::triggered);
+
+    pacer.schedule();
+    QVERIFY(spy.wait(1000));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // A request made immediately after a trigger is delayed to the end of the refresh interval.
+    pacer.schedule();
+    QVERIFY(spy.wait(1000));
+    QCOMPARE(spy.count(), 2);
+    QVERIFY(timer.elapsed() >= pacer.getInterval() / 2);
+}
+
+[[maybe_unused]] void RefreshPacerTest::testStop() {
+    RefreshPacer pacer;
+    const QSignalSpy spy(&pacer, &RefreshPacer::triggered);
+
+    pacer.schedule();
+    pacer.stop();
+    QVERIFY(!pacer.isScheduled());
+
+    QTest::qWait(3 * pacer.getInterval());
+    QCOMPARE(spy.count(), 0);
+}
+
+[[maybe_unused]] void RefreshPacerTest::testMarkPerformed() {
+    RefreshPacer pacer;
+    QSignalSpy spy(&pacer, &RefreshPacer::triggered);
+
+    pacer.schedule();
+    pacer.markPerformed();
+    QVERIFY(!pacer.isScheduled());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // The next trigger is paced from when the action was performed.
+    pacer.schedule();
+    QVERIFY(spy.wait(1000));
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(timer.elapsed() >= pacer.getInterval() / 2);
+}
+
+
+QTEST_MAIN(RefreshPacerTest)
+
+#include "RefreshPacerTest.moc"
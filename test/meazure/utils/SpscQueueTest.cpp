@@ -0,0 +1,144 @@
+/*
+ * Copyright 2023 C Thing Software
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QtPlugin>
+#include <QThread>
+#include <meazure/utils/SpscQueue.h>
+#include <memory>
+
+Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+Q_IMPORT_PLUGIN(QSvgIconPlugin)
+
+
+class SpscQueueTest : public QObject {
+
+Q_OBJECT
+
+private slots:
+    [[maybe_unused]] void testEmpty();
+    [[maybe_unused]] void testPushPop();
+    [[maybe_unused]] void testFull();
+    [[maybe_unused]] void testWrap();
+    [[maybe_unused]] void testClear();
+    [[maybe_unused]] void testThreads();
+};
+
+
+[[maybe_unused]] void SpscQueueTest::testEmpty() {
+    SpscQueue<int, 4> queue;
+    QVERIFY(queue.isEmpty());
+
+    int value = 0;
+    QVERIFY(!queue.pop(value));
+}
+
+[[maybe_unused]] void SpscQueueTest::testPushPop() {
+    SpscQueue<int, 4> queue;
+    QVERIFY(queue.push(1));
+    QVERIFY(queue.push(2));
+    QVERIFY(!queue.isEmpty());
+
+    int value = 0;
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 1);
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 2);
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(value));
+}
+
+[[maybe_unused]] void SpscQueueTest::testFull() {
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; i++) {
+        QVERIFY(queue.push(i));
+    }
+    QVERIFY(!queue.push(4));
+
+    int value = 0;
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 0);
+    QVERIFY(queue.push(4));
+    QVERIFY(!queue.push(5));
+}
+
+[[maybe_unused]] void SpscQueueTest::testWrap() {
+    SpscQueue<int, 4> queue;
+    int value = 0;
+
+    for (int i = 0; i < 100; i++) {
+        QVERIFY(queue.push(i));
+        QVERIFY(queue.push(i + 1000));
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, i);
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, i + 1000);
+    }
+    QVERIFY(queue.isEmpty());
+}
+
+[[maybe_unused]] void SpscQueueTest::testClear() {
+    SpscQueue<int, 4> queue;
+    QVERIFY(queue.push(1));
+    QVERIFY(queue.push(2));
+
+    queue.clear();
+    QVERIFY(queue.isEmpty());
+
+    int value = 0;
+    QVERIFY(!queue.pop(value));
+    QVERIFY(queue.push(3));
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 3);
+}
+
+[[maybe_unused]] void SpscQueueTest::testThreads() {
+    constexpr int count = 100000;
+    SpscQueue<int, 16> queue;
+
+    const std::unique_ptr<QThread> producer(QThread::create([&queue]() {
+        for (int i = 0; i < count;) {
+            if (queue.push(i)) {
+                i++;
+            } else {
+                QThread::yieldCurrentThread();
+            }
+        }
+    }));
+    producer->start();
+
+    // Values must be received in the order they were sent, without loss or duplication.
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        int value = 0;
+        if (queue.pop(value)) {
+            ordered = ordered && (value == expected);
+            expected++;
+        } else {
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    QVERIFY(producer->wait());
+    QVERIFY(ordered);
+    QVERIFY(queue.isEmpty());
+}
+
+QTEST_MAIN(SpscQueueTest)
+
+#include "SpscQueueTest.moc"